@@ -15,7 +15,8 @@ uniform uint lightCount;
 
 uniform mat4 view;
 
-uniform sampler2D texSampler;
+uniform sampler2DArray texSampler;
+uniform uint texLayer;
 
 in vec3 fragPos;
 in vec4 fragColors;
@@ -53,5 +54,5 @@ void main()
     }
 
     vec4 result = vec4(finalColor, opacity) * fragColors;
-    outColor = texture2D(texSampler, fragTexCoord) * result;
+    outColor = texture(texSampler, vec3(fragTexCoord, float(texLayer))) * result;
 }
@@ -13,14 +13,25 @@
 #include "EventProvider.hpp"
 #include "Event.hpp"
 #include "graphics/Shader.hpp"
+#include "graphics/GpuTimers.hpp"
+#include "graphics/GLState.hpp"
+#include "graphics/GLUploader.hpp"
+#include "graphics/GpuBufferCache.hpp"
+#include "graphics/TextureCache.hpp"
 #include "component.hpp"
 #include "Context.hpp"
+#include "TimerWheel.hpp"
+#include "Replay.hpp"
+#include "FrameStats.hpp"
+#include "Profiler.hpp"
 
 #include "resources/ResourceLoader.hpp"
 
 #include "widgets/ComponentInspector.hpp"
 #include "widgets/EntityHierarchy.hpp"
 #include "widgets/EventMonitor.hpp"
+#include "widgets/FrameStatsMonitor.hpp"
+#include "widgets/ProfilerView.hpp"
 #include "widgets/Recorder.hpp"
 #include "widgets/Console.hpp"
 
@@ -45,20 +56,38 @@ private:
     ComponentInspector component_inspector;
     EntityHierarchy entity_hierarchy;
     std::unique_ptr<EventMonitor> event_monitor;
+    std::unique_ptr<FrameStatsMonitor> frame_stats_monitor;
+    ProfilerView profiler_view;
     std::unique_ptr<Recorder> recorder;
 
     std::unique_ptr<EventProvider> events;
+    std::unique_ptr<Replay> replay;
 
     // todo : should be an entity
     std::unique_ptr<Window> window;
 
     ResourceLoader loader;
+    TimerWheel timers;
+    // note : heap allocated, the histograms are a few hundred KiB
+    std::unique_ptr<FrameStats> frame_stats;
+    std::unique_ptr<GpuTimers> gpu_timers;
+    // note : started once the render context exists, stopped before GLFW is terminated
+    GLUploader uploader;
+    GLState gl_state;
+    GpuBufferCache buffers{uploader};
+    TextureCache textures{loader, gl_state, uploader};
 
     entt::dispatcher dispatcher;
     entt::registry world;
     std::unique_ptr<Context> ctx;
     std::unique_ptr<System> system;
 
+    // note : while fast forwarding a replay, only a few frames are presented so the replay is not bound by the vsync
+    static constexpr auto FAST_FORWARD_PRESENT_INTERVAL = 250ms;
+    std::chrono::steady_clock::time_point last_present;
+
+    auto process(const event::Event &event) -> void;
+
     auto on_imgui(const kawe::action::Render<kawe::Render::Layout::UI>) -> void;
 };
 
@@ -2,7 +2,9 @@
 
 #include <array>
 #include <chrono>
+#include <string>
 #include <string_view>
+#include <type_traits>
 #include <variant>
 
 #include <magic_enum.hpp>
@@ -397,6 +399,33 @@ using Event = std::variant<
 
     >;
 
+/// index of `T` in the Event variant
+template<typename T, std::size_t I = 0>
+constexpr auto index_of() noexcept -> std::size_t
+{
+    if constexpr (std::is_same_v<std::variant_alternative_t<I, Event>, T>) {
+        return I;
+    } else {
+        return index_of<T, I + 1>();
+    }
+}
+
+/// name of the type held by `event`, with its source if it has one (e.g. "Pressed<Key>")
+inline auto type_name(const Event &event) -> std::string
+{
+    return std::visit(
+        []<typename T>(const T &) -> std::string {
+            if constexpr (std::is_same_v<T, std::monostate>) {
+                return "None";
+            } else if constexpr (requires { decltype(T::source)::name; }) {
+                return std::string{T::name} + "<" + std::string{decltype(T::source)::name} + ">";
+            } else {
+                return std::string{T::name};
+            }
+        },
+        event);
+}
+
 } // namespace event
 
 } // namespace kawe
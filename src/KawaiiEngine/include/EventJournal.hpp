@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "graphics/deps.hpp"
+#include "Event.hpp"
+#include "binary/EventLog.hpp"
+
+namespace kawe {
+
+/// Stream the processed events to a `.kawelog` file from a writer thread.
+/// The events are handed over in chunks, each chunk is written as one block of the log.
+class EventJournal {
+public:
+    explicit EventJournal(std::filesystem::path path);
+    ~EventJournal();
+
+    EventJournal(const EventJournal &) = delete;
+    auto operator=(const EventJournal &) -> EventJournal & = delete;
+
+    auto record(const event::Event &event) -> void;
+
+    /// hand the current chunk to the writer thread
+    auto flush() -> void;
+
+    /// write a copy of everything recorded until now to `path`, done by the writer thread
+    /// the copy is converted to json if `path` has the `.json` extension
+    auto exportTo(std::filesystem::path path) -> void;
+
+    /// drop the events recorded and start a new journal at `path`
+    /// the previous journal file is deleted, unless it has been exported since it was started
+    auto restart(std::filesystem::path path) -> void;
+
+    /// flush, close the journal and stop the writer thread
+    auto close() -> void;
+
+    auto size() const noexcept -> std::size_t { return m_count; }
+
+    /// true while an export is queued or running
+    auto isExporting() const noexcept -> bool { return m_exports_pending != 0; }
+
+    /// progress of the running export, between 0 and 1
+    auto getExportProgress() const noexcept -> float
+    {
+        const auto total = m_export_total.load();
+        return total == 0 ? 0.0f : static_cast<float>(m_export_done.load()) / static_cast<float>(total);
+    }
+
+    auto getPath() const noexcept -> const std::filesystem::path & { return m_path; }
+
+private:
+    static constexpr std::size_t CHUNK_SIZE = 1024;
+    static constexpr std::size_t MAX_PENDING_JOBS = 64;
+
+    struct Job {
+        enum class Kind { WRITE, EXPORT, REOPEN };
+
+        Kind kind;
+        std::vector<event::Event> chunk;
+        std::filesystem::path path;
+    };
+
+    // producer side
+    std::filesystem::path m_path;
+    std::vector<event::Event> m_chunk;
+    std::size_t m_count{0};
+
+    // shared
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Job> m_jobs;
+    bool m_stop{false};
+
+    // exports state, written by the writer thread
+    std::atomic<std::size_t> m_exports_pending{0};
+    std::atomic<std::size_t> m_export_done{0};
+    std::atomic<std::size_t> m_export_total{0};
+
+    // writer side
+    std::unique_ptr<binary::EventLogWriter> m_file;
+    std::filesystem::path m_file_path;
+    bool m_file_exported{false};
+    std::thread m_writer;
+
+    auto submit(Job &&job) -> void;
+    auto run() -> void;
+    /// close the current journal file, and delete it if it has not been exported
+    auto retire() -> void;
+    auto open(const std::filesystem::path &path) -> void;
+    auto write(const std::vector<event::Event> &chunk) -> void;
+    auto copy(const std::filesystem::path &path) -> void;
+};
+
+} // namespace kawe
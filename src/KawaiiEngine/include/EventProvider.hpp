@@ -1,9 +1,16 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
 #include <vector>
 #include <chrono>
 
 #include "graphics/Window.hpp"
+#include "helpers/RingBuffer.hpp"
+#include "EventJournal.hpp"
+#include "EventSource.hpp"
 #include "Event.hpp"
 
 namespace kawe {
@@ -12,24 +19,97 @@ class Window;
 
 class EventProvider {
 public:
+    static constexpr std::size_t EVENT_TYPE_COUNT = std::variant_size_v<event::Event>;
+
     EventProvider(const Window &window);
 
+    /// fetch the window events, should be called once per frame
+    auto pollEvents() -> void { ::glfwPollEvents(); }
+
+    /// return the pending events in order, then a TimeElapsed once the queue is drained
     auto getNextEvent() -> event::Event;
-    auto getLastEventWhere(const std::function<bool(const event::Event &)> &predicate) const noexcept
-        -> std::optional<const event::Event *>;
 
-    auto getEventsProcessed() const noexcept -> const std::vector<event::Event> &
+    /// last processed event of type `T`, nullptr if there is none
+    template<typename T>
+    auto getLastEvent() const noexcept -> const T *
+    {
+        return std::get_if<T>(&m_last_event_by_type[event::index_of<T>()]);
+    }
+
+    /// last processed event of the `type`-th type of event::Event, std::monostate if there is none
+    auto getLastEventOfType(std::size_t type) const noexcept -> const event::Event &
+    {
+        return m_last_event_by_type[type];
+    }
+
+    /// last processed event which is not a TimeElapsed, std::monostate if there is none
+    auto getLastInputEvent() const noexcept -> const event::Event & { return m_last_event_by_type[m_last_input_type]; }
+
+    template<typename T>
+    auto getEventCount() const noexcept -> std::size_t
+    {
+        return m_event_count_by_type[event::index_of<T>()];
+    }
+
+    /// number of processed events for each type of event::Event, indexed like the variant
+    auto getEventCountByType() const noexcept -> const std::array<std::size_t, EVENT_TYPE_COUNT> &
+    {
+        return m_event_count_by_type;
+    }
+
+    auto getInputEventCount() const noexcept -> std::size_t { return m_input_count; }
+
+    auto getEventsProcessedCount() const noexcept -> std::size_t { return m_journal.size(); }
+
+    auto getJournal() noexcept -> EventJournal & { return m_journal; }
+
+    auto getEventsPendingCount() const noexcept -> std::size_t
+    {
+        return m_captured_events.size() + (m_playback ? m_playback->remaining() : 0)
+               + (m_playback_front.has_value() ? 1 : 0);
+    }
+
+    /// replay `source` before the captured inputs
+    auto setPendingEvents(std::unique_ptr<EventSource> source) noexcept -> void
     {
-        return m_events_processed;
+        m_playback = std::move(source);
+        m_playback_front.reset();
     }
 
-    auto getEventsPending() const noexcept -> const std::vector<event::Event> & { return m_buffer_events; }
+    auto setPendingEvents(std::vector<event::Event> &&in) -> void
+    {
+        setPendingEvents(std::make_unique<VectorEventSource>(std::move(in)));
+    }
+
+    /// number of events of the replayed log, it is kept once replayed so it can still be seeked
+    auto getPlaybackSize() const noexcept -> std::size_t { return m_playback ? m_playback->size() : 0; }
 
-    auto setPendingEvents(std::vector<event::Event> &&in) noexcept -> void
+    /// number of events of the replayed log fully processed
+    auto getPlaybackPosition() const noexcept -> std::size_t
     {
-        m_buffer_events = std::move(in);
+        if (!m_playback) { return 0; }
+        return m_playback->position() - (m_playback_front.has_value() ? 1 : 0);
     }
 
+    /// false while a recorded TimeElapsed is split over several frames
+    auto isPlaybackAtEventBoundary() const noexcept -> bool { return !m_playback_front.has_value(); }
+
+    /// restart the playback from the `index`-th event of the replayed log
+    auto seekPlayback(std::size_t index) -> bool
+    {
+        m_playback_front.reset();
+        if (!m_playback || !m_playback->seek(index)) { return false; }
+        if (m_state != State::PLAYBACK) { setState(State::PLAYBACK); }
+        return true;
+    }
+
+    // time between the capture of the last input and its processing
+    auto getLastInputLatency() const noexcept -> std::chrono::nanoseconds { return m_last_input_latency; }
+
+    auto getEventsDropped() const noexcept -> std::size_t { return m_events_dropped.load(std::memory_order_relaxed); }
+
+    auto getEventsCoalesced() const noexcept -> std::size_t { return m_events_coalesced; }
+
     auto setCurrentTimepoint(const std::chrono::steady_clock::time_point &t) -> void { m_lastTimePoint = t; }
 
     auto getTimeScaler() const noexcept -> const double & { return m_time_scaler; }
@@ -37,8 +117,13 @@ public:
 
     auto clear() -> void
     {
-        m_buffer_events.clear();
-        m_events_processed.clear();
+        m_captured_events.clear();
+        setPendingEvents(nullptr);
+        m_last_event_by_type = {};
+        m_event_count_by_type = {};
+        m_last_input_type = 0;
+        m_input_count = 0;
+        m_journal.restart(make_journal_path());
     }
 
     enum class State {
@@ -48,6 +133,19 @@ public:
 
     auto getState() const noexcept { return m_state; }
 
+    enum class PlaybackMode {
+        REAL_TIME,    // wait the recorded time between frames and move the window like it was
+        FAST_FORWARD, // feed the recorded time to the simulation as fast as possible, without touching the window
+    };
+
+    auto getPlaybackMode() const noexcept { return m_playback_mode; }
+    auto setPlaybackMode(PlaybackMode mode) noexcept -> void { m_playback_mode = mode; }
+
+    auto isFastForwarding() const noexcept -> bool
+    {
+        return m_state == State::PLAYBACK && m_playback_mode == PlaybackMode::FAST_FORWARD;
+    }
+
     auto setState(State s)
     {
         m_state = s;
@@ -80,15 +178,41 @@ private:
 
     std::chrono::steady_clock::time_point m_lastTimePoint;
 
-    std::vector<event::Event> m_buffer_events; // input buffer
+    struct CapturedEvent {
+        std::chrono::steady_clock::time_point timestamp;
+        event::Event event;
+    };
+
+    static constexpr std::size_t CAPTURE_CAPACITY = 4096;
+
+    // input buffer, filled by the GLFW callbacks
+    RingBuffer<CapturedEvent, CAPTURE_CAPACITY> m_captured_events;
+    // note : counted by the capturing thread, read by the monitor
+    std::atomic<std::size_t> m_events_dropped{0};
+    std::size_t m_events_coalesced{0};
+    std::chrono::nanoseconds m_last_input_latency{};
+
+    // loaded log, consumed before the input buffer
+    std::unique_ptr<EventSource> m_playback;
+    std::optional<event::Event> m_playback_front;
+
+    // note : indexed by the type of event, updated when an event is processed so the queries don t scan the history
+    std::array<event::Event, EVENT_TYPE_COUNT> m_last_event_by_type{};
+    std::array<std::size_t, EVENT_TYPE_COUNT> m_event_count_by_type{};
+    std::size_t m_last_input_type{0};
+    std::size_t m_input_count{0};
 
-    std::vector<event::Event> m_events_processed; // previous event
+    EventJournal m_journal;
 
     double m_time_scaler{1.0};
 
     State m_state{State::RECORD};
+    PlaybackMode m_playback_mode{PlaybackMode::REAL_TIME};
 
     auto fetchEvent() -> event::Event;
+    static auto make_journal_path() -> std::filesystem::path;
+    auto capture(event::Event &&event) -> void;
+    auto coalesce(event::Event &event) -> void;
     auto getElapsedTime() noexcept -> std::chrono::nanoseconds;
 
     static auto callback_eventClose(::GLFWwindow *window) -> void;
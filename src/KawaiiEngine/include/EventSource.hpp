@@ -0,0 +1,57 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "graphics/deps.hpp"
+#include "Event.hpp"
+
+namespace kawe {
+
+/// A recorded stream of events, replayed by the EventProvider.
+struct EventSource {
+    virtual ~EventSource() = default;
+
+    virtual auto next() -> std::optional<event::Event> = 0;
+
+    /// number of events which can still be read
+    virtual auto remaining() const noexcept -> std::size_t = 0;
+
+    virtual auto size() const noexcept -> std::size_t = 0;
+
+    /// index of the next event to be read
+    auto position() const noexcept -> std::size_t { return size() - remaining(); }
+
+    /// move the cursor so the next event read is the `index`-th one
+    virtual auto seek(std::size_t index) -> bool = 0;
+};
+
+class VectorEventSource final : public EventSource {
+public:
+    explicit VectorEventSource(std::vector<event::Event> &&events) : m_events{std::move(events)} {}
+
+    auto next() -> std::optional<event::Event> override
+    {
+        if (m_cursor == m_events.size()) { return {}; }
+        return m_events[m_cursor++];
+    }
+
+    auto remaining() const noexcept -> std::size_t override { return m_events.size() - m_cursor; }
+
+    auto size() const noexcept -> std::size_t override { return m_events.size(); }
+
+    auto seek(std::size_t index) -> bool override
+    {
+        if (index > m_events.size()) { return false; }
+        m_cursor = index;
+        return true;
+    }
+
+private:
+    std::vector<event::Event> m_events;
+    std::size_t m_cursor{0};
+};
+
+} // namespace kawe
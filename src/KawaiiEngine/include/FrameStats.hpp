@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "helpers/Histogram.hpp"
+#include "Profiler.hpp"
+
+namespace kawe {
+
+/// Frame time statistics: the last frame times for plotting, and histograms of the frame time and of the time spent
+/// in each system since the last reset. Nothing is allocated once constructed.
+class FrameStats {
+public:
+    using Clock = std::chrono::steady_clock;
+    // note : nanoseconds, with 64 sub buckets the percentiles are within 1.6%
+    using TimeHistogram = Histogram<6, 40>;
+
+    static constexpr std::size_t HISTORY_SIZE = 256;
+    static constexpr std::size_t MAX_SECTIONS = 32;
+    /// the section gathering the ones registered past MAX_SECTIONS
+    static constexpr std::string_view OTHERS_NAME = "<others>";
+    static constexpr auto DEFAULT_BUDGET = std::chrono::nanoseconds{16'666'667};
+
+    struct Section {
+        std::string_view name;
+        TimeHistogram histogram;
+        std::chrono::nanoseconds last{0};
+
+        // current frame
+        std::chrono::nanoseconds accumulated{0};
+        std::size_t calls{0};
+        std::size_t depth{0};
+    };
+
+    /// measure the time spent in a section until destroyed, also opening a profiler zone of the same name
+    /// a section re-entered while it is measured (e.g. a signal triggering itself) is only counted once
+    class Scope {
+    public:
+        Scope(Section &section) : m_section{section}, m_zone{section.name.data()}
+        {
+            if (m_section.depth++ == 0) { m_start = Clock::now(); }
+        }
+
+        ~Scope()
+        {
+            if (--m_section.depth == 0) {
+                m_section.accumulated += Clock::now() - m_start;
+                m_section.calls++;
+            }
+        }
+
+        Scope(const Scope &) = delete;
+        auto operator=(const Scope &) -> Scope & = delete;
+
+    private:
+        Section &m_section;
+        Profiler::Scope m_zone;
+        Clock::time_point m_start;
+    };
+
+    /// the time is inclusive, a section triggering another one is also charged for it
+    /// `name` must outlive the stats, meant to be a string literal
+    [[nodiscard]] auto measure(std::string_view name) -> Scope { return Scope{section(name)}; }
+
+    /// add a time measured elsewhere (e.g. read back from the GPU) to a section of the current frame
+    auto add(std::string_view name, std::chrono::nanoseconds time) -> void
+    {
+        auto &added = section(name);
+        added.accumulated += time;
+        added.calls++;
+    }
+
+    /// close the current frame, its duration is the time since the previous call
+    auto end_frame() -> void;
+
+    auto record_frame(std::chrono::nanoseconds frame_time) -> void;
+
+    auto reset() -> void;
+
+    auto getFrameHistogram() const noexcept -> const TimeHistogram & { return m_frames; }
+    auto getSections() const noexcept -> std::span<const Section> { return {m_sections.data(), m_section_count}; }
+
+    /// frame times in milliseconds, the oldest one is at `getHistoryOffset()`
+    auto getHistory() const noexcept -> std::span<const float>
+    {
+        return {m_history.data(), std::min<std::size_t>(m_frames.count(), HISTORY_SIZE)};
+    }
+    auto getHistoryOffset() const noexcept -> std::size_t
+    {
+        return m_frames.count() < HISTORY_SIZE ? 0 : m_history_next;
+    }
+
+    auto getLastFrameTime() const noexcept -> std::chrono::nanoseconds { return m_last_frame; }
+
+    auto getBudget() const noexcept -> std::chrono::nanoseconds { return m_budget; }
+    auto setBudget(std::chrono::nanoseconds budget) noexcept -> void { m_budget = budget; }
+
+    /// number of frames longer than the budget
+    auto getHitchCount() const noexcept -> std::uint64_t { return m_hitches; }
+
+    /// write the percentiles of the frames and of every section, as csv if `path` has the `.csv` extension,
+    /// as json otherwise
+    auto exportTo(const std::filesystem::path &path) const -> bool;
+
+private:
+    TimeHistogram m_frames;
+    std::array<float, HISTORY_SIZE> m_history{};
+    std::size_t m_history_next{0};
+    std::chrono::nanoseconds m_last_frame{0};
+
+    std::chrono::nanoseconds m_budget{DEFAULT_BUDGET};
+    std::uint64_t m_hitches{0};
+
+    // note : the extra slot is the one of OTHERS_NAME
+    std::array<Section, MAX_SECTIONS + 1> m_sections;
+    std::size_t m_section_count{0};
+
+    std::optional<Clock::time_point> m_frame_start;
+
+    auto section(std::string_view name) -> Section &;
+};
+
+} // namespace kawe
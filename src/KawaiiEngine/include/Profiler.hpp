@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#    include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#endif
+
+#include "helpers/RingBuffer.hpp"
+
+namespace kawe {
+
+/// Scoped CPU zones profiler.
+/// Each thread pushes the zones it closes in its own ring buffer, the buffers are drained by the main thread
+/// when a frame ends. The zones are compiled out unless KAWE_ENABLE_PROFILER is defined.
+class Profiler {
+public:
+    static constexpr std::size_t THREAD_BUFFER_SIZE = 1 << 14;
+    static constexpr std::size_t FRAME_HISTORY = 256;
+
+    struct Zone {
+        // note : a string literal, never copied
+        const char *name{nullptr};
+        std::uint64_t begin{0};
+        std::uint64_t end{0};
+        std::uint32_t depth{0};
+        std::uint32_t thread{0};
+    };
+
+    struct Frame {
+        std::uint64_t begin{0};
+        std::uint64_t end{0};
+        std::vector<Zone> zones;
+    };
+
+    struct ThreadInfo {
+        std::uint32_t id;
+        std::string name;
+    };
+
+#ifdef KAWE_ENABLE_PROFILER
+    class Scope {
+    public:
+        explicit Scope(const char *name) noexcept : m_name{name}, m_depth{t_depth++}, m_begin{Profiler::now()} {}
+
+        ~Scope()
+        {
+            const auto end = Profiler::now();
+            t_depth--;
+            Profiler::get().push({m_name, m_begin, end, m_depth, 0});
+        }
+
+        Scope(const Scope &) = delete;
+        auto operator=(const Scope &) -> Scope & = delete;
+
+    private:
+        const char *m_name;
+        std::uint32_t m_depth;
+        std::uint64_t m_begin;
+    };
+#else
+    class Scope {
+    public:
+        explicit constexpr Scope(const char *) noexcept {}
+    };
+#endif
+
+    static auto get() -> Profiler &;
+
+    /// timestamp in ticks, the time stamp counter when available
+    static auto now() noexcept -> std::uint64_t
+    {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    /// name shown in the traces for the calling thread
+    auto setThreadName(std::string name) -> void;
+
+    /// drain the zones of every thread and close the current frame, called by the main thread
+    auto endFrame() -> void;
+
+    /// while paused the frames are not recorded, the zones are still drained
+    auto setPaused(bool paused) noexcept -> void { m_paused = paused; }
+    auto isPaused() const noexcept -> bool { return m_paused; }
+
+    /// the recorded frames, the oldest first
+    auto getFrames() const -> std::vector<const Frame *>;
+    auto getThreads() const -> std::vector<ThreadInfo>;
+    auto getDroppedZones() const noexcept -> std::size_t { return m_dropped; }
+
+    auto toNanoseconds(std::uint64_t ticks) const noexcept -> double
+    {
+        return static_cast<double>(ticks) * m_ns_per_tick;
+    }
+
+    /// write the recorded frames in the chrome trace event format (chrome://tracing, perfetto)
+    auto exportChromeTrace(const std::filesystem::path &path) const -> bool;
+
+    static constexpr auto isEnabled() noexcept -> bool
+    {
+#ifdef KAWE_ENABLE_PROFILER
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+    Profiler();
+
+    struct ThreadBuffer {
+        RingBuffer<Zone, THREAD_BUFFER_SIZE> zones;
+        std::uint32_t id;
+        std::string name;
+        std::atomic<std::size_t> dropped{0};
+    };
+
+    static thread_local std::uint32_t t_depth;
+
+    auto push(const Zone &zone) -> void;
+    auto buffer() -> ThreadBuffer &;
+    auto calibrate() -> void;
+
+    mutable std::mutex m_threads_mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> m_threads;
+    std::uint32_t m_next_thread_id{0};
+
+    std::array<Frame, FRAME_HISTORY> m_frames;
+    std::size_t m_frame_count{0};
+    std::uint64_t m_frame_begin{0};
+    bool m_paused{false};
+    std::size_t m_dropped{0};
+
+    std::uint64_t m_calibration_ticks{0};
+    std::chrono::steady_clock::time_point m_calibration_time;
+    double m_ns_per_tick{1.0};
+};
+
+} // namespace kawe
+
+#define KAWE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define KAWE_PROFILE_CONCAT(a, b) KAWE_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef KAWE_ENABLE_PROFILER
+#    define KAWE_PROFILE_ZONE(name) \
+        const ::kawe::Profiler::Scope KAWE_PROFILE_CONCAT(kawe_profile_zone_, __COUNTER__)(name)
+#else
+#    define KAWE_PROFILE_ZONE(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "EventProvider.hpp"
+#include "WorldSnapshot.hpp"
+
+namespace kawe {
+
+/// Keyframes of the world taken while replaying a log, used to seek in it.
+/// A seek restores the nearest keyframe before the target then fast forwards to it, so it never replays more than
+/// `KEYFRAME_INTERVAL` events: a target past `getSeekLimit` is clamped to it.
+// note : the keyframes can not be taken ahead of the playback, the world is only simulated by playing the log
+class Replay {
+public:
+    static constexpr std::size_t KEYFRAME_INTERVAL = 2048;
+
+    Replay(entt::registry &world, EventProvider &provider, Context &ctx, TimerWheel &timers) :
+        m_world{world}, m_provider{provider}, m_ctx{ctx}, m_timers{timers}
+    {
+    }
+
+    /// called once the frame has been simulated, take a keyframe or apply a seek requested during the frame
+    auto on_frame_end() -> void;
+
+    /// the seek is applied at the end of the current frame
+    auto requestSeek(std::size_t event_index) noexcept -> void { m_seek_request = event_index; }
+
+    /// a new log is replayed, the keyframes of the previous one are dropped
+    auto reset() -> void;
+
+    auto isSeeking() const noexcept -> bool { return m_seek_target.has_value(); }
+
+    auto getKeyframes() const noexcept -> const std::vector<WorldSnapshot> & { return m_keyframes; }
+
+    /// the furthest event a seek can reach, one interval past the last keyframe
+    auto getSeekLimit() const noexcept -> std::size_t
+    {
+        return m_keyframes.empty() ? 0 : m_keyframes.back().event_index + KEYFRAME_INTERVAL;
+    }
+
+private:
+    entt::registry &m_world;
+    EventProvider &m_provider;
+    Context &m_ctx;
+    TimerWheel &m_timers;
+
+    // sorted by event index
+    std::vector<WorldSnapshot> m_keyframes;
+
+    std::optional<std::size_t> m_seek_request;
+    std::optional<std::size_t> m_seek_target;
+    EventProvider::PlaybackMode m_mode_before_seek{EventProvider::PlaybackMode::REAL_TIME};
+
+    auto seek(std::size_t event_index) -> void;
+    auto finishSeek() -> void;
+};
+
+} // namespace kawe
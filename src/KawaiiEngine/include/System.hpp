@@ -1,6 +1,11 @@
 #pragma once
 
 #include "Action.hpp"
+#include "FrameStats.hpp"
+#include "graphics/GpuTimers.hpp"
+#include "graphics/GLState.hpp"
+#include "graphics/GpuBufferCache.hpp"
+#include "graphics/TextureCache.hpp"
 
 namespace kawe {
 
@@ -8,9 +13,21 @@ struct System {
     entt::registry &my_world;
     Context &ctx;
     Window &window;
+    FrameStats &stats;
+    GpuTimers &gpu_timers;
+    GLState &gl_state;
+    GpuBufferCache &buffers;
+    TextureCache &textures;
 
     System(entt::registry &world, entt::dispatcher &dispatcher, Context &context, Window &w) :
-        my_world{world}, ctx{context}, window{w}
+        my_world{world},
+        ctx{context},
+        window{w},
+        stats{*world.ctx<FrameStats *>()},
+        gpu_timers{*world.ctx<GpuTimers *>()},
+        gl_state{*world.ctx<GLState *>()},
+        buffers{*world.ctx<GpuBufferCache *>()},
+        textures{*world.ctx<TextureCache *>()}
     {
         {
             // rendering backend memory cleanup
@@ -29,6 +46,13 @@ struct System {
                 .connect<Render::VBO<Render::VAO::Attribute::TEXTURE_2D>::on_destroy>();
 
             my_world.on_destroy<Render::EBO>().connect<Render::EBO::on_destroy>();
+
+            my_world.on_destroy<Texture2D>().connect<Texture2D::on_destroy>();
+        }
+
+        {
+            // scheduled timers cleanup
+            my_world.on_destroy<Clock>().connect<Clock::on_destroy>();
         }
 
         {
@@ -79,7 +103,7 @@ struct System {
         }
 
         {
-            // updating clocks.
+            // updating clocks, only the due ones are visited.
             dispatcher.sink<event::TimeElapsed>().connect<&System::on_time_elapsed_clock>(*this);
         }
 
@@ -96,6 +120,7 @@ struct System {
 
     auto on_update_aabb(entt::registry &reg, entt::entity e) -> void
     {
+        const auto measured = stats.measure("aabb");
         if (const auto collider = reg.try_get<Collider>(e); collider != nullptr) {
             if (const auto vbo = reg.try_get<Render::VBO<Render::VAO::Attribute::POSITION>>(e); vbo != nullptr) {
                 AABB::emplace(reg, e, vbo->vertices);
@@ -105,6 +130,7 @@ struct System {
 
     auto run_collision_pipeline(entt::registry &reg, entt::entity e) -> void
     {
+        const auto measured = stats.measure("collision");
         // AABB algorithm = really simple and fast collision detection
         const auto aabb = reg.get<AABB>(e);
         bool has_aabb_collision = false;
@@ -137,6 +163,7 @@ struct System {
 
     auto on_fill_color_update(entt::registry &reg, entt::entity e) -> void
     {
+        const auto measured = stats.measure("fill color");
         const auto vbo_color = reg.try_get<Render::VBO<Render::VAO::Attribute::COLOR>>(e);
         const auto vbo_pos = reg.try_get<Render::VBO<Render::VAO::Attribute::POSITION>>(e);
         if (!vbo_color && !vbo_pos) return;
@@ -158,6 +185,7 @@ struct System {
 
     auto on_create_camera(entt::registry &reg, entt::entity e) -> void
     {
+        const auto measured = stats.measure("camera");
         const auto child = reg.create();
         reg.emplace<Position3f>(child);
         reg.emplace<Parent>(child, e);
@@ -169,6 +197,7 @@ struct System {
 
     auto on_update_camera(entt::registry &reg, entt::entity e) -> void
     {
+        const auto measured = stats.measure("camera");
         const auto &cam = reg.try_get<CameraData>(e);
         if (cam == nullptr) { return; }
         const auto &pos = reg.get_or_emplace<Position3f>(e, Position3f{glm::dvec3{1.0, 1.0, 1.0}});
@@ -204,6 +233,7 @@ struct System {
 
     auto try_update_camera_target(entt::registry &reg, entt::entity e) -> void
     {
+        const auto measured = stats.measure("camera");
         if (const auto has_parent = reg.try_get<Parent>(e); has_parent != nullptr) {
             if (const auto is_camera = reg.try_get<CameraData>(has_parent->component); is_camera != nullptr) {
                 on_update_camera(reg, has_parent->component);
@@ -213,6 +243,7 @@ struct System {
 
     auto on_time_elapsed_camera(const event::TimeElapsed &e) -> void
     {
+        const auto measured = stats.measure("camera");
         const auto dt_nano = e.elapsed;
         const auto dt_secs =
             static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(dt_nano).count()) / 1'000'000.0;
@@ -267,11 +298,13 @@ struct System {
 
     auto on_time_elapsed_clock(const event::TimeElapsed &e) -> void
     {
-        my_world.view<Clock>().each([&e](Clock &clock) { clock.on_update(e); });
+        const auto measured = stats.measure("clock");
+        my_world.ctx<TimerWheel *>()->advance(e.world_time);
     }
 
     auto on_time_elapsed_physics(const event::TimeElapsed &e) -> void
     {
+        const auto measured = stats.measure("physics");
         const auto dt_secs =
             static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(e.world_time).count()) / 1'000'000.0;
 
@@ -290,6 +323,35 @@ struct System {
     }
 
     auto on_time_elapsed_render(const action::Render<Render::Layout::SCENE> &e) -> void;
+
+    /// diameter in pixels of the bounding sphere of an entity seen by a camera
+    auto projected_size(const CameraData &cam, entt::entity e, const glm::dmat4 &model) const -> double
+    {
+        // note : without an AABB the mesh is assumed to fit in the unit sphere
+        auto center = glm::dvec3{model[3]};
+        auto radius = std::max(
+            {glm::length(glm::dvec3{model[0]}), glm::length(glm::dvec3{model[1]}), glm::length(glm::dvec3{model[2]})});
+        if (const auto aabb = my_world.try_get<AABB>(e); aabb != nullptr) {
+            center = (aabb->min + aabb->max) * 0.5;
+            radius = glm::length(aabb->max - aabb->min) * 0.5;
+        }
+
+        const auto depth = -(cam.view * glm::dvec4{center, 1.0}).z;
+        if (depth <= radius) { return std::numeric_limits<double>::max(); }
+
+        const auto height = window.getSize<double>().y * static_cast<double>(cam.viewport.h);
+        return radius * cam.projection[1][1] / depth * height;
+    }
+
+    /// the content of every buffer of the entity has been uploaded
+    template<typename... Buffers>
+    auto is_uploaded(entt::entity e) const -> bool
+    {
+        return (... && [&] {
+            const auto buffer = my_world.try_get<Buffers>(e);
+            return buffer == nullptr || buffers.isReady(buffer->object);
+        }());
+    }
 };
 
 } // namespace kawe
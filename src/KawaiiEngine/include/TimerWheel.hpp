@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace kawe {
+
+/// Hierarchical timing wheel driven by the world time.
+/// Only the slots reached by the current tick are visited, so idle timers cost nothing per frame.
+class TimerWheel {
+public:
+    using duration = std::chrono::milliseconds;
+    using Callback = std::function<void(void)>;
+
+    struct Handle {
+        std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+        std::uint32_t generation = 0;
+    };
+
+    TimerWheel() { m_slots.fill(NIL); }
+
+    /// schedule `callback` to be called after `delay`, then every `period` if `period` is not null
+    auto schedule(duration delay, Callback callback, duration period = duration::zero()) -> Handle;
+
+    /// return false if the timer already expired or was already cancelled
+    auto cancel(const Handle &handle) noexcept -> bool;
+
+    auto is_pending(const Handle &handle) const noexcept -> bool;
+
+    /// move the wheel forward, calling every timer which became due in the interval
+    auto advance(std::chrono::steady_clock::duration world_time) -> void;
+
+    /// cancel every timer, the current tick and the time not ticked yet are kept so `now` goes on
+    auto clear() noexcept -> void;
+
+    auto now() const noexcept -> duration { return duration{static_cast<duration::rep>(m_current_tick)}; }
+
+    auto size() const noexcept -> std::size_t { return m_active; }
+
+private:
+    static constexpr std::uint32_t SLOT_BITS = 6;
+    static constexpr std::uint32_t SLOT_COUNT = 1u << SLOT_BITS;
+    static constexpr std::uint32_t SLOT_MASK = SLOT_COUNT - 1;
+    static constexpr std::uint32_t LEVEL_COUNT = 5; // 2^30 ms, around 12 days
+    static constexpr std::uint64_t MAX_DELTA = (std::uint64_t{1} << (SLOT_BITS * LEVEL_COUNT)) - 1;
+
+    static constexpr std::uint32_t NIL = std::numeric_limits<std::uint32_t>::max();
+
+    enum class NodeState : std::uint8_t { FREE, PENDING, FIRING, CANCELLED };
+
+    struct Node {
+        Callback callback;
+        std::uint64_t expire_tick = 0;
+        std::uint64_t period = 0;
+        std::uint32_t generation = 0;
+        std::uint32_t prev = NIL;
+        std::uint32_t next = NIL;
+        std::uint32_t slot = NIL;
+        NodeState state = NodeState::FREE;
+    };
+
+    // note : a deque keeps the references stable while a callback schedules new timers
+    std::deque<Node> m_nodes;
+    std::vector<std::uint32_t> m_free;
+    std::array<std::uint32_t, SLOT_COUNT * LEVEL_COUNT> m_slots;
+
+    std::uint64_t m_current_tick = 0;
+    std::chrono::steady_clock::duration m_remainder{};
+    std::size_t m_active = 0;
+
+    auto get(const Handle &handle) noexcept -> Node *;
+    auto insert(std::uint32_t index) noexcept -> void;
+    auto unlink(std::uint32_t index) noexcept -> void;
+    auto release(std::uint32_t index) noexcept -> void;
+    auto cascade(std::uint32_t level) noexcept -> void;
+    auto tick() -> void;
+};
+
+} // namespace kawe
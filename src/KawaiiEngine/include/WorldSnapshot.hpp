@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "component.hpp"
+#include "Context.hpp"
+#include "TimerWheel.hpp"
+
+namespace kawe {
+
+namespace details {
+
+template<typename Variant>
+struct SnapshotStorage;
+
+template<typename... Components>
+struct SnapshotStorage<std::variant<std::monostate, Components...>> {
+    using type = std::tuple<std::vector<std::pair<entt::entity, Components>>...>;
+};
+
+template<typename T>
+constexpr bool is_vbo = false;
+
+template<Render::VAO::Attribute A>
+constexpr bool is_vbo<Render::VBO<A>> = true;
+
+} // namespace details
+
+/// Copy of the components listed in kawe::Component, of the timers and of the inputs state.
+/// The components owning GPU objects are not copied as is, they are recreated from their data if needed.
+/// The geometry of the buffers is not copied either, the snapshot shares the storage the components view.
+struct WorldSnapshot {
+    // number of events of the replayed log processed when the snapshot was taken
+    std::size_t event_index{0};
+
+    std::vector<entt::entity> entities;
+    details::SnapshotStorage<Component>::type components;
+    TimerWheel timers;
+
+    glm::dvec2 mouse_pos{};
+    glm::dvec2 mouse_pos_when_pressed{};
+    std::unordered_map<event::MouseButton::Button, bool> state_mouse_button;
+    std::unordered_map<event::Key::Code, bool> keyboard_state;
+
+    static auto take(entt::registry &world, const Context &ctx, const TimerWheel &timers, std::size_t event_index)
+        -> WorldSnapshot
+    {
+        WorldSnapshot snapshot{.event_index = event_index, .timers = timers};
+
+        world.each([&snapshot](const auto entity) { snapshot.entities.push_back(entity); });
+        std::ranges::sort(snapshot.entities);
+
+        std::apply([&world](auto &... saved) { (save(world, saved), ...); }, snapshot.components);
+
+        snapshot.mouse_pos = ctx.mouse_pos;
+        snapshot.mouse_pos_when_pressed = ctx.mouse_pos_when_pressed;
+        snapshot.state_mouse_button = ctx.state_mouse_button;
+        snapshot.keyboard_state = ctx.keyboard_state;
+        return snapshot;
+    }
+
+    auto restore(entt::registry &world, Context &ctx, TimerWheel &out_timers) const -> void
+    {
+        destroy_unknown_entities(world);
+        for (const auto &entity : entities) {
+            if (!world.valid(entity)) { [[maybe_unused]] const auto created = world.create(entity); }
+        }
+
+        // note : adding a component may trigger a system modifying an other one (e.g. the camera creating its
+        //        target), so everything is written again once every component exists, then the extra entities
+        //        are removed
+        std::apply([&world](const auto &... saved) { (restore_components(world, saved), ...); }, components);
+        std::apply([&world](const auto &... saved) { (overwrite_components(world, saved), ...); }, components);
+        destroy_unknown_entities(world);
+
+        ctx.mouse_pos = mouse_pos;
+        ctx.mouse_pos_when_pressed = mouse_pos_when_pressed;
+        ctx.state_mouse_button = state_mouse_button;
+        ctx.keyboard_state = keyboard_state;
+
+        out_timers = timers;
+    }
+
+private:
+    template<typename T>
+    static auto save(entt::registry &world, std::vector<std::pair<entt::entity, T>> &saved) -> void
+    {
+        for (const auto entity : world.view<T>()) { saved.emplace_back(entity, world.get<T>(entity)); }
+        std::ranges::sort(saved, std::less{}, &std::pair<entt::entity, T>::first);
+    }
+
+    auto is_known(entt::entity entity) const noexcept -> bool
+    {
+        return std::ranges::binary_search(entities, entity);
+    }
+
+    auto destroy_unknown_entities(entt::registry &world) const -> void
+    {
+        std::vector<entt::entity> unknown;
+        world.each([this, &unknown](const auto entity) {
+            if (!is_known(entity)) { unknown.push_back(entity); }
+        });
+        world.destroy(unknown.begin(), unknown.end());
+    }
+
+    template<typename T>
+    static auto restore_components(entt::registry &world, const std::vector<std::pair<entt::entity, T>> &saved)
+        -> void
+    {
+        std::vector<entt::entity> added;
+        for (const auto entity : world.view<T>()) {
+            if (!std::ranges::binary_search(saved, entity, std::less{}, &std::pair<entt::entity, T>::first)) {
+                added.push_back(entity);
+            }
+        }
+        world.remove<T>(added.begin(), added.end());
+
+        for (const auto &[entity, component] : saved) { restore_component(world, entity, component); }
+    }
+
+    template<typename T>
+    static auto restore_component(entt::registry &world, entt::entity entity, const T &component) -> void
+    {
+        if constexpr (std::is_same_v<T, Mesh>) {
+            if (const auto current = world.try_get<Mesh>(entity);
+                current == nullptr || current->filepath != component.filepath) {
+                Mesh::emplace(world, entity, component.filepath);
+            }
+        } else if constexpr (std::is_same_v<T, Texture2D>) {
+            if (const auto current = world.try_get<Texture2D>(entity);
+                current == nullptr || current->filepath != component.filepath) {
+                Texture2D::emplace(world, entity, component.filepath);
+            }
+        } else if constexpr (std::is_same_v<T, Render::VAO>) {
+            if (world.try_get<Render::VAO>(entity) == nullptr) { Render::VAO::emplace(world, entity); }
+        } else if constexpr (details::is_vbo<T>) {
+            if (const auto current = world.try_get<T>(entity);
+                current == nullptr || current->stride_size != component.stride_size
+                || current->vertices.data() != component.vertices.data()
+                || current->vertices.size() != component.vertices.size()) {
+                T::emplace(world, entity, component.vertices, component.stride_size, component.storage);
+            }
+        } else if constexpr (std::is_same_v<T, Render::EBO>) {
+            if (const auto current = world.try_get<Render::EBO>(entity);
+                current == nullptr || current->indices.data() != component.indices.data()
+                || current->indices.size() != component.indices.size()) {
+                world.remove_if_exists<Render::EBO>(entity);
+                Render::EBO::emplace(world, entity, component.indices, component.storage);
+            }
+        } else {
+            if (const auto current = world.try_get<T>(entity); current != nullptr) {
+                *current = component;
+            } else {
+                world.emplace<T>(entity, component);
+            }
+        }
+    }
+
+    template<typename T>
+    static auto overwrite_components(entt::registry &world, const std::vector<std::pair<entt::entity, T>> &saved)
+        -> void
+    {
+        for (const auto &[entity, component] : saved) {
+            if constexpr (std::is_same_v<T, Render::VAO>) {
+                // note : the vertex array is the one alive, only its parameters come from the snapshot
+                auto &vao = world.get<Render::VAO>(entity);
+                vao.mode = component.mode;
+                vao.count = component.count;
+                vao.shader_program = component.shader_program;
+            } else if constexpr (
+                !std::is_same_v<T, Mesh> && !std::is_same_v<T, Texture2D> && !details::is_vbo<T>
+                && !std::is_same_v<T, Render::EBO>) {
+                world.get<T>(entity) = component;
+            }
+        }
+    }
+};
+
+} // namespace kawe
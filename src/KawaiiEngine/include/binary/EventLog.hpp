@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "EventSource.hpp"
+#include "helpers/MappedFile.hpp"
+
+namespace kawe {
+
+namespace binary {
+
+/**
+ * Layout of a `.kawelog` file, all the integers are little endian:
+ *
+ * header : magic "KAWELOG\0", u16 version, u16 flags, u32 reserved
+ * blocks : u32 event count, u32 raw size, u32 stored size, payload
+ *
+ * The payload is compressed when `stored size < raw size`.
+ * The events are encoded as a u8 tag (index in the event::Event variant) followed by a packed payload,
+ * the durations and the cursor coordinates are delta encoded, the state is reset at each block,
+ * so every block can be decoded on its own.
+ */
+struct EventLogFormat {
+    static constexpr std::array<char, 8> MAGIC{'K', 'A', 'W', 'E', 'L', 'O', 'G', '\0'};
+    static constexpr std::uint16_t VERSION = 1;
+    static constexpr std::size_t HEADER_SIZE = 16;
+    static constexpr std::size_t BLOCK_HEADER_SIZE = 12;
+
+    enum Flags : std::uint16_t {
+        NONE = 0,
+        COMPRESSED = 1 << 0,
+    };
+
+    static constexpr auto EXTENSION = ".kawelog";
+
+    /// previous values used by the delta encoding, reset at each block
+    struct DeltaState {
+        std::int64_t elapsed{0};
+        std::int64_t world_time{0};
+        std::array<std::int64_t, 2> window{0, 0};
+        std::array<std::int64_t, 2> mouse{0, 0};
+    };
+};
+
+class EventLogWriter {
+public:
+    explicit EventLogWriter(const std::filesystem::path &path, bool compress = true);
+
+    auto is_open() const noexcept -> bool { return m_file.is_open(); }
+
+    /// encode `events` as one block
+    auto write(std::span<const event::Event> events) -> void;
+
+    auto flush() -> void { m_file.flush(); }
+
+    auto size() const noexcept -> std::size_t { return m_count; }
+
+private:
+    std::ofstream m_file;
+    bool m_compress;
+    std::size_t m_count{0};
+
+    std::vector<std::uint8_t> m_raw;
+    std::vector<std::uint8_t> m_stored;
+};
+
+/// Decode lazily a memory mapped `.kawelog` file, one block at a time.
+class EventLogReader final : public EventSource {
+public:
+    explicit EventLogReader(const std::filesystem::path &path);
+
+    auto is_open() const noexcept -> bool { return m_valid; }
+
+    auto next() -> std::optional<event::Event> override;
+
+    auto remaining() const noexcept -> std::size_t override { return m_count - m_position; }
+
+    auto size() const noexcept -> std::size_t override { return m_count; }
+
+    /// only the block holding `index` is decoded
+    auto seek(std::size_t index) -> bool override;
+
+private:
+    struct Block {
+        std::size_t offset;
+        std::size_t first_event;
+        std::uint32_t count;
+        std::uint32_t raw_size;
+        std::uint32_t stored_size;
+    };
+
+    MappedFile m_file;
+    bool m_valid{false};
+    std::vector<Block> m_blocks;
+    std::size_t m_count{0};
+    std::size_t m_position{0};
+
+    // current block
+    std::size_t m_block{0};
+    std::uint32_t m_block_count{0};
+    std::uint32_t m_decoded_in_block{0};
+    std::vector<std::uint8_t> m_buffer;
+    std::span<const std::uint8_t> m_payload;
+    std::size_t m_cursor{0};
+    EventLogFormat::DeltaState m_state;
+
+    auto load_block(std::size_t index) -> bool;
+};
+
+/// encode one block of events to `out`
+auto encode(std::span<const event::Event> events, std::vector<std::uint8_t> &out) -> void;
+
+/// convert a json array of events to a `.kawelog` file
+auto convert_json_to_log(const std::filesystem::path &json, const std::filesystem::path &log) -> bool;
+
+/// convert a `.kawelog` file to a json array of events, `on_progress` is called with the events written and the total
+auto convert_log_to_json(
+    const std::filesystem::path &log,
+    const std::filesystem::path &json,
+    const std::function<void(std::size_t, std::size_t)> &on_progress = {}) -> bool;
+
+} // namespace binary
+
+} // namespace kawe
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include "helpers/MappedFile.hpp"
+
+namespace kawe {
+
+namespace binary {
+
+/**
+ * Layout of a `.kmesh` file, a mesh cooked to be uploaded as is, all the integers are little endian:
+ *
+ * header  : magic "KAWEMSH\0", u16 version, u16 reserved, u32 reserved,
+ *           u64 source size, i64 source mtime, u64 source hash,
+ *           f32 min[3], f32 max[3], u64 vertex count, u64 index count
+ * streams : positions (3 f32), normals (3 f32), texcoords (2 f32) per vertex, then the u32 indices,
+ *           each one starting at the next multiple of the alignment
+ *
+ * The file of a mesh is named after the hash of the source path. It is used as long as the size and the mtime of the
+ * source match, or its content hash if they do not, so touching the source does not cook it again.
+ */
+struct MeshFormat {
+    static constexpr std::array<char, 8> MAGIC{'K', 'A', 'W', 'E', 'M', 'S', 'H', '\0'};
+    static constexpr std::uint16_t VERSION = 2;
+    static constexpr std::size_t HEADER_SIZE = 80;
+    static constexpr std::size_t ALIGNMENT = 16;
+
+    static constexpr auto EXTENSION = ".kmesh";
+};
+
+/// A cooked mesh, memory mapped, its streams point straight into the mapping.
+class MeshFile {
+public:
+    /// what identifies the content of a source file
+    struct Source {
+        std::uint64_t size;
+        std::int64_t mtime;
+        std::uint64_t hash;
+    };
+
+    /// the streams of a mesh to cook
+    struct Streams {
+        std::span<const float> positions;
+        std::span<const float> normals;
+        std::span<const float> texcoords;
+        std::span<const std::uint32_t> indices;
+    };
+
+    /// size, mtime and content hash of `source`, empty if it can not be read
+    static auto describe(const std::filesystem::path &source) -> std::optional<Source>;
+
+    static auto path_of(const std::filesystem::path &directory, const std::filesystem::path &source)
+        -> std::filesystem::path;
+
+    /// map the cooked file of `source`, empty if it is missing, invalid or the source changed since
+    static auto open(const std::filesystem::path &path, const std::filesystem::path &source)
+        -> std::optional<MeshFile>;
+
+    /// the content of the cooked file of a mesh, every vertex having a normal and a texcoord
+    static auto cook(const Streams &streams, const Source &source) -> std::vector<std::uint8_t>;
+
+    static auto from_memory(std::vector<std::uint8_t> bytes) -> std::optional<MeshFile>;
+
+    /// write a cooked file, through a temporary file so a crash never leaves a truncated one
+    static auto save(const std::filesystem::path &path, std::span<const std::uint8_t> bytes) -> bool;
+
+    auto getPositions() const noexcept -> std::span<const float> { return m_positions; }
+    auto getNormals() const noexcept -> std::span<const float> { return m_normals; }
+    auto getTexcoords() const noexcept -> std::span<const float> { return m_texcoords; }
+    auto getIndices() const noexcept -> std::span<const std::uint32_t> { return m_indices; }
+    auto getMin() const noexcept -> const glm::vec3 & { return m_min; }
+    auto getMax() const noexcept -> const glm::vec3 & { return m_max; }
+
+private:
+    MeshFile() = default;
+
+    // note : either mapped from the disk or just cooked
+    MappedFile m_file;
+    std::vector<std::uint8_t> m_memory;
+    Source m_source{};
+    glm::vec3 m_min{};
+    glm::vec3 m_max{};
+    std::span<const float> m_positions;
+    std::span<const float> m_normals;
+    std::span<const float> m_texcoords;
+    std::span<const std::uint32_t> m_indices;
+
+    /// check the header and the sizes of the streams and find them
+    auto parse(std::span<const std::uint8_t> bytes) -> bool;
+};
+
+} // namespace binary
+
+} // namespace kawe
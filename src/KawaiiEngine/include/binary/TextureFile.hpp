@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "helpers/MappedFile.hpp"
+
+namespace kawe {
+
+struct Texture;
+
+namespace binary {
+
+/**
+ * Layout of a `.kawetex` file, a texture cooked to be uploaded as is, all the integers are little endian:
+ *
+ * header : magic "KAWETEX\0", u16 version, u16 format, u32 width, u32 height, u32 levels, u64 source hash
+ * levels : u64 offset, u64 size for each level, from the base level to 1x1
+ * data   : the pixels of every level, each one starting at its offset
+ *
+ * The file of an image is named after the hash of the source file and the format, so editing the image cooks it
+ * again and the stale file is simply never used.
+ */
+struct TextureFormat {
+    static constexpr std::array<char, 8> MAGIC{'K', 'A', 'W', 'E', 'T', 'E', 'X', '\0'};
+    static constexpr std::uint16_t VERSION = 1;
+    static constexpr std::size_t HEADER_SIZE = 32;
+    static constexpr std::size_t LEVEL_SIZE = 16;
+    static constexpr std::size_t ALIGNMENT = 16;
+
+    static constexpr auto EXTENSION = ".kawetex";
+
+    enum class Format : std::uint16_t {
+        RGBA8,
+        // 4x4 blocks of 16 bytes, BC1 color and BC4 alpha, a quarter of RGBA8
+        BC3,
+    };
+
+    static constexpr auto internal_format(Format format) noexcept -> GLenum
+    {
+        return format == Format::BC3 ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_RGBA8;
+    }
+
+    static constexpr auto level_size(Format format, std::uint32_t width, std::uint32_t height) noexcept -> std::size_t
+    {
+        if (format == Format::BC3) { return std::size_t{(width + 3) / 4} * ((height + 3) / 4) * 16; }
+        return std::size_t{width} * height * 4;
+    }
+};
+
+/// A cooked texture, memory mapped.
+class TextureFile {
+public:
+    using Format = TextureFormat::Format;
+
+    struct Level {
+        std::uint32_t width;
+        std::uint32_t height;
+        std::span<const std::uint8_t> data;
+    };
+
+    /// hash of the content of the source image, empty if it can not be read
+    static auto hash_source(const std::filesystem::path &source) -> std::optional<std::uint64_t>;
+
+    static auto path_of(const std::filesystem::path &directory, std::uint64_t source_hash, Format format)
+        -> std::filesystem::path;
+
+    /// map a cooked file, empty if it is missing or does not match
+    static auto open(const std::filesystem::path &path, std::uint64_t source_hash, Format format)
+        -> std::optional<TextureFile>;
+
+    /// the content of the cooked file of `image`: its full mip chain in `format`
+    static auto cook(const Texture &image, std::uint64_t source_hash, Format format) -> std::vector<std::uint8_t>;
+
+    static auto from_memory(std::vector<std::uint8_t> bytes, std::uint64_t source_hash, Format format)
+        -> std::optional<TextureFile>;
+
+    /// write a cooked file, through a temporary file so a crash never leaves a truncated one
+    static auto save(const std::filesystem::path &path, std::span<const std::uint8_t> bytes) -> bool;
+
+    auto getFormat() const noexcept -> Format { return m_format; }
+    auto getLevels() const noexcept -> std::span<const Level> { return m_levels; }
+
+private:
+    TextureFile() = default;
+
+    // note : either mapped from the disk or just cooked
+    MappedFile m_file;
+    std::vector<std::uint8_t> m_memory;
+    Format m_format{Format::RGBA8};
+    std::vector<Level> m_levels;
+
+    /// check the header against the expected hash and format and find the levels
+    auto parse(std::span<const std::uint8_t> bytes, std::uint64_t source_hash, Format format) -> bool;
+};
+
+} // namespace binary
+
+} // namespace kawe
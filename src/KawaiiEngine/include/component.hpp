@@ -6,6 +6,9 @@
 #include <variant>
 #include <limits>
 #include <functional>
+#include <span>
+#include <memory>
+#include <vector>
 
 #include <glm/glm.hpp>
 #include <magic_enum.hpp>
@@ -14,9 +17,13 @@
 #include <GL/glew.h>
 
 #include "helpers/Rectangle.hpp"
+#include "graphics/GLState.hpp"
+#include "graphics/GpuBufferCache.hpp"
+#include "graphics/TextureCache.hpp"
 
 #include "resources/ResourceLoader.hpp"
 #include "Context.hpp"
+#include "TimerWheel.hpp"
 
 using namespace std::chrono_literals;
 
@@ -119,13 +126,15 @@ struct Render {
         DisplayMode mode;
         GLsizei count;
         ShaderProgram *shader_program;
+        /// the buffers have been attached again since they have been uploaded, see `Render::attach`
+        bool attached{false};
 
         static constexpr DisplayMode DEFAULT_MODE{DisplayMode::TRIANGLES};
 
         static auto emplace(entt::registry &world, const entt::entity &entity) -> VAO &
         {
             spdlog::trace("engine::core::VAO: emplace to {}", entity);
-            VAO obj{0u, DEFAULT_MODE, 0, world.ctx<Context *>()->shaders[0].get()};
+            VAO obj{0u, DEFAULT_MODE, 0, world.ctx<Context *>()->shaders[0].get(), false};
             CALL_OPEN_GL(::glGenVertexArrays(1, &obj.object));
             return world.emplace<VAO>(entity, obj);
         }
@@ -134,6 +143,7 @@ struct Render {
         {
             spdlog::trace("engine::core::VAO: destroy of {}", entity);
             const auto &vao = world.get<VAO>(entity);
+            world.ctx<GLState *>()->forgetVertexArray(vao.object);
             CALL_OPEN_GL(::glDeleteVertexArrays(1, &vao.object));
         }
 
@@ -145,12 +155,18 @@ struct Render {
         static std::string name;
 
         unsigned int object;
-        std::vector<float> vertices;
+        /// a view on `storage`, the vertices are only copied when they are not owned by one
+        std::span<const float> vertices;
         std::size_t stride_size;
-
-        static auto
-            emplace(entt::registry &world, const entt::entity &entity, const std::vector<float> &in_vertices, std::size_t in_stride_size)
-                -> VBO<A> &
+        std::shared_ptr<const void> storage;
+
+        /// `storage` owns `in_vertices` if given, e.g. a mapped mesh file, the upload then reads them in place
+        static auto emplace(
+            entt::registry &world,
+            const entt::entity &entity,
+            std::span<const float> in_vertices,
+            std::size_t in_stride_size,
+            std::shared_ptr<const void> storage = nullptr) -> VBO<A> &
         {
             spdlog::trace("engine::core::VBO<{}>: emplace to {}", magic_enum::enum_name(A).data(), entity);
 
@@ -166,27 +182,24 @@ struct Render {
                     });
             }
 
-            CALL_OPEN_GL(::glBindVertexArray(vao->object));
-
-            VBO<A> obj{0u, std::move(in_vertices), in_stride_size};
-            CALL_OPEN_GL(::glGenBuffers(1, &obj.object));
+            world.ctx<GLState *>()->bindVertexArray(vao->object);
 
-            CALL_OPEN_GL(::glBindBuffer(GL_ARRAY_BUFFER, obj.object));
-            CALL_OPEN_GL(::glBufferData(
-                GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(obj.vertices.size() * sizeof(float)), obj.vertices.data(), GL_STATIC_DRAW));
-            CALL_OPEN_GL(::glVertexAttribPointer(
-                static_cast<GLuint>(A),
-                static_cast<GLint>(obj.stride_size),
-                GL_FLOAT,
-                GL_FALSE,
-                static_cast<GLsizei>(obj.stride_size * static_cast<int>(sizeof(float))),
-                0));
-            CALL_OPEN_GL(::glEnableVertexAttribArray(static_cast<GLuint>(A)));
-
-            if (const auto ebo = world.try_get<EBO>(entity); ebo == nullptr) {
-                world.patch<VAO>(
-                    entity, [&obj](VAO &vao_obj) { vao_obj.count = static_cast<GLsizei>(obj.vertices.size()); });
+            // note : the key of a content without storage is its hash, the copy owned by the component is then the one
+            //        the cache uploads and compares, it does not stage one of its own
+            const auto key = GpuBufferCache::key_of(GL_ARRAY_BUFFER, in_vertices, storage.get());
+            if (storage == nullptr) {
+                auto owned = std::make_shared<const std::vector<float>>(in_vertices.begin(), in_vertices.end());
+                in_vertices = *owned;
+                storage = std::move(owned);
             }
+            const auto object = world.ctx<GpuBufferCache *>()->acquire(key, in_vertices.data(), storage);
+            VBO<A> obj{object, in_vertices, in_stride_size, std::move(storage)};
+            obj.attach();
+
+            world.patch<VAO>(entity, [&obj, has_ebo = world.try_get<EBO>(entity) != nullptr](VAO &vao_obj) {
+                if (!has_ebo) { vao_obj.count = static_cast<GLsizei>(obj.vertices.size()); }
+                vao_obj.attached = false;
+            });
 
             world.remove_if_exists<VBO<A>>(entity);
             return world.emplace<VBO<A>>(entity, obj);
@@ -197,14 +210,28 @@ struct Render {
             emplace(entt::registry &world, const entt::entity &entity, const std::array<float, S> &in_vertices, std::size_t in_stride_size)
                 -> VBO<A> &
         {
-            return emplace(world, entity, std::vector<float>(in_vertices.begin(), in_vertices.end()), in_stride_size);
+            return emplace(world, entity, std::span<const float>{in_vertices}, in_stride_size);
+        }
+
+        /// attach the buffer to the attribute `A` of the bound vertex array
+        auto attach() const -> void
+        {
+            CALL_OPEN_GL(::glBindBuffer(GL_ARRAY_BUFFER, object));
+            CALL_OPEN_GL(::glVertexAttribPointer(
+                static_cast<GLuint>(A),
+                static_cast<GLint>(stride_size),
+                GL_FLOAT,
+                GL_FALSE,
+                static_cast<GLsizei>(stride_size * static_cast<int>(sizeof(float))),
+                0));
+            CALL_OPEN_GL(::glEnableVertexAttribArray(static_cast<GLuint>(A)));
         }
 
         static auto on_destroy(entt::registry &world, const entt::entity &entity) -> void
         {
             spdlog::trace("engine::core::VBO<{}>: destroy of {}", magic_enum::enum_name(A).data(), entity);
             const auto &vbo = world.get<VBO<A>>(entity);
-            CALL_OPEN_GL(::glDeleteBuffers(1, &vbo.object));
+            world.ctx<GpuBufferCache *>()->release(vbo.object);
         }
     };
 
@@ -212,46 +239,83 @@ struct Render {
         static constexpr std::string_view name{"EBO"};
 
         unsigned int object;
-        std::vector<std::uint32_t> indices;
+        /// a view on `storage`, the indices are only copied when they are not owned by one
+        std::span<const std::uint32_t> indices;
+        std::shared_ptr<const void> storage;
 
         template<std::size_t S>
         static auto emplace(entt::registry &world, const entt::entity &entity, const std::array<std::uint32_t, S> &indices)
             -> EBO &
         {
-            return emplace(world, entity, std::vector<std::uint32_t>(indices.begin(), indices.end()));
+            return emplace(world, entity, std::span<const std::uint32_t>{indices});
         }
 
-        static auto emplace(entt::registry &world, const entt::entity &entity, const std::vector<std::uint32_t> &indices)
-            -> EBO &
+        /// `storage` owns `indices` if given, e.g. a mapped mesh file, the upload then reads them in place
+        static auto emplace(
+            entt::registry &world,
+            const entt::entity &entity,
+            std::span<const std::uint32_t> indices,
+            std::shared_ptr<const void> storage = nullptr) -> EBO &
         {
             spdlog::trace("engine::core::EBO: emplace of {}", entity);
 
             const VAO *vao{nullptr};
             if (vao = world.try_get<VAO>(entity); !vao) { vao = &VAO::emplace(world, entity); }
-            CALL_OPEN_GL(::glBindVertexArray(vao->object));
-
-            EBO obj{0u, std::move(indices)};
-            CALL_OPEN_GL(::glGenBuffers(1, &obj.object));
-
-            CALL_OPEN_GL(::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, obj.object));
-            CALL_OPEN_GL(::glBufferData(
-                GL_ELEMENT_ARRAY_BUFFER,
-                static_cast<GLsizei>(obj.indices.size() * sizeof(uint32_t)),
-                obj.indices.data(),
-                GL_STATIC_DRAW));
+            world.ctx<GLState *>()->bindVertexArray(vao->object);
+
+            // note : as for the VBO, the cache shares the copy owned by the component
+            const auto key = GpuBufferCache::key_of(GL_ELEMENT_ARRAY_BUFFER, indices, storage.get());
+            if (storage == nullptr) {
+                auto owned = std::make_shared<const std::vector<std::uint32_t>>(indices.begin(), indices.end());
+                indices = *owned;
+                storage = std::move(owned);
+            }
+            const auto object = world.ctx<GpuBufferCache *>()->acquire(key, indices.data(), storage);
+            EBO obj{object, indices, std::move(storage)};
 
-            world.patch<VAO>(entity, [&obj](VAO &vao_obj) { vao_obj.count = static_cast<GLsizei>(obj.indices.size()); });
+            world.patch<VAO>(entity, [&obj](VAO &vao_obj) {
+                vao_obj.count = static_cast<GLsizei>(obj.indices.size());
+                vao_obj.attached = false;
+            });
 
-            return world.emplace_or_replace<EBO>(entity, obj);
+            // note : replacing would not release the previous buffer
+            world.remove_if_exists<EBO>(entity);
+            return world.emplace<EBO>(entity, obj);
         }
 
         static auto on_destroy(entt::registry &world, const entt::entity &entity) -> void
         {
             spdlog::trace("engine::core::EBO: destroy of {}", entity);
             const auto &ebo = world.get<EBO>(entity);
-            CALL_OPEN_GL(::glDeleteBuffers(1, &ebo.object));
+            world.ctx<GpuBufferCache *>()->release(ebo.object);
         }
     };
+
+    /// attach again the buffers of the entity to its vertex array, once `GpuBufferCache::isReady` for all of them
+    // note : the content written by the upload context is only visible to this one through a binding made after the
+    //        fence, the attachments recorded by the vertex array while it was uploading may not see it
+    static auto attach(entt::registry &world, const entt::entity &entity) -> void
+    {
+        auto &vao = world.get<VAO>(entity);
+        world.ctx<GLState *>()->bindVertexArray(vao.object);
+        attach_vbos<
+            VAO::Attribute::POSITION,
+            VAO::Attribute::COLOR,
+            VAO::Attribute::TEXTURE_2D,
+            VAO::Attribute::NORMALS>(world, entity);
+        if (const auto ebo = world.try_get<EBO>(entity); ebo != nullptr) {
+            CALL_OPEN_GL(::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo->object));
+        }
+        vao.attached = true;
+    }
+
+    template<VAO::Attribute... A>
+    static auto attach_vbos(entt::registry &world, const entt::entity &entity) -> void
+    {
+        (..., [&] {
+            if (const auto vbo = world.try_get<VBO<A>>(entity); vbo != nullptr) { vbo->attach(); }
+        }());
+    }
 };
 
 template<Render::VAO::Attribute A>
@@ -267,7 +331,7 @@ struct AABB {
 
     entt::entity guizmo{entt::null};
 
-    static auto emplace(entt::registry &world, entt::entity e, const std::vector<float> &vertices) -> AABB &
+    static auto emplace(entt::registry &world, entt::entity e, std::span<const float> vertices) -> AABB &
     {
         glm::dvec3 min = {
             std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
@@ -409,10 +473,11 @@ struct Mesh {
         const Render::VAO *vao{nullptr};
         if (vao = world.try_get<Render::VAO>(entity); !vao) { vao = &Render::VAO::emplace(world, entity); }
 
-        Render::VBO<Render::VAO::Attribute::POSITION>::emplace(world, entity, model->vertices, 3);
-        Render::VBO<Render::VAO::Attribute::TEXTURE_2D>::emplace(world, entity, model->texcoords, 2);
-        Render::VBO<Render::VAO::Attribute::NORMALS>::emplace(world, entity, model->normals, 3);
-        Render::EBO::emplace(world, entity, model->indices);
+        // note : the components and their buffers view the mapped model, the inspector only copies what it edits
+        Render::VBO<Render::VAO::Attribute::POSITION>::emplace(world, entity, model->vertices, 3, model->storage);
+        Render::VBO<Render::VAO::Attribute::TEXTURE_2D>::emplace(world, entity, model->texcoords, 2, model->storage);
+        Render::VBO<Render::VAO::Attribute::NORMALS>::emplace(world, entity, model->normals, 3, model->storage);
+        Render::EBO::emplace(world, entity, model->indices, model->storage);
 
         return world.emplace_or_replace<Mesh>(entity, filepath, std::filesystem::path(filepath).filename().string(), true);
     }
@@ -429,48 +494,24 @@ struct Texture2D {
     static constexpr std::string_view name{"Texture2D"};
 
     std::string filepath;
-    std::uint32_t textureID;
-    std::shared_ptr<Texture> ref_resource;
+    // note : resolved to a layer when drawing, the image may still be loading
+    TextureCache::Handle image;
 
     static const Texture2D empty;
 
     static auto emplace(entt::registry &world, entt::entity e, const std::string &filepath) -> Texture2D &
     {
-        auto &loader = *world.ctx<kawe::ResourceLoader *>();
-        Texture2D texture{filepath, 0u, loader.load<Texture>(filepath)};
-
-        if (!texture.ref_resource) {
-            texture.ref_resource = std::make_shared<Texture>();
-            return world.emplace_or_replace<Texture2D>(e, texture);
-        }
-
-        CALL_OPEN_GL(::glGenTextures(1, &texture.textureID));
-        CALL_OPEN_GL(::glBindTexture(GL_TEXTURE_2D, texture.textureID));
+        Texture2D texture{filepath, world.ctx<TextureCache *>()->acquire(filepath)};
 
-        CALL_OPEN_GL(::glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, texture.ref_resource->width, texture.ref_resource->height));
-        CALL_OPEN_GL(::glTexSubImage2D(
-            GL_TEXTURE_2D,
-            0,
-            0,
-            0,
-            texture.ref_resource->width,
-            texture.ref_resource->height,
-            GL_RGBA,
-            GL_UNSIGNED_BYTE,
-            texture.ref_resource->data));
-        CALL_OPEN_GL(::glGenerateMipmap(GL_TEXTURE_2D));
-
-
-        // CALL_OPEN_GL(::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT)); // GL_MIRRORED_REPEAT
-        // CALL_OPEN_GL(::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT)); // GL_MIRRORED_REPEAT
-
-        // CALL_OPEN_GL(::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
-        // CALL_OPEN_GL(::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-
-
-        CALL_OPEN_GL(::glBindTexture(GL_TEXTURE_2D, 0));
+        // note : replacing would not release the previous texture
+        world.remove_if_exists<Texture2D>(e);
+        return world.emplace<Texture2D>(e, texture);
+    }
 
-        return world.emplace_or_replace<Texture2D>(e, texture);
+    static auto on_destroy(entt::registry &world, const entt::entity &entity) -> void
+    {
+        spdlog::trace("engine::core::Texture2D: destroy of {}", entity);
+        world.ctx<TextureCache *>()->release(world.get<Texture2D>(entity).image);
     }
 };
 
@@ -498,28 +539,30 @@ struct Clock {
     static constexpr std::string_view name{"Clock"};
 
     std::function<void(void)> callback;
-    std::chrono::milliseconds refresh_rate;
-    std::chrono::milliseconds current;
+    std::chrono::milliseconds refresh_rate{};
+    bool repeat{true};
+
+    TimerWheel::Handle timer{};
 
     static auto emplace(
         entt::registry &world,
         const entt::entity &entity,
         const std::chrono::milliseconds &refresh_rate,
-        const std::function<void(void)> &callback) -> Clock &
+        const std::function<void(void)> &callback,
+        bool repeat = true) -> Clock &
     {
-        return world.emplace<Clock>(entity, callback, refresh_rate, 0ms);
+        auto &timers = *world.ctx<TimerWheel *>();
+        const auto handle = timers.schedule(refresh_rate, callback, repeat ? refresh_rate : 0ms);
+        return world.emplace<Clock>(entity, callback, refresh_rate, repeat, handle);
     }
 
-    void on_update(const kawe::event::TimeElapsed &e)
+    static auto cancel(entt::registry &world, const entt::entity &entity) -> void
     {
-        current += std::chrono::duration_cast<std::chrono::milliseconds>(e.world_time);
-
-        if (current >= refresh_rate) {
-            callback();
-            current = 0ms;
-        }
+        world.ctx<TimerWheel *>()->cancel(world.get<Clock>(entity).timer);
     }
-}; // namespace kawe
+
+    static auto on_destroy(entt::registry &world, const entt::entity &entity) -> void { cancel(world, entity); }
+};
 
 struct Pickable {
     static constexpr std::string_view name{"Pickable"};
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+#include <GL/glew.h>
+
+namespace kawe {
+
+inline constexpr auto GetGLErrorStr(GLenum err)
+{
+    switch (err) {
+    case GL_NO_ERROR: return "OPEN_GL: No error";
+    case GL_INVALID_ENUM: return "OPEN_GL: Invalid enum";
+    case GL_INVALID_VALUE: return "OPEN_GL: Invalid value";
+    case GL_INVALID_OPERATION: return "OPEN_GL: Invalid operation";
+    case GL_STACK_OVERFLOW: return "OPEN_GL: Stack overflow";
+    case GL_STACK_UNDERFLOW: return "OPEN_GL: Stack underflow";
+    case GL_OUT_OF_MEMORY: return "OPEN_GL: Out of memory";
+    default: return "OPEN_GL: Unknown error";
+    }
+}
+
+enum class GLCallKind { OTHER, DRAW, STATE, UPLOAD };
+
+/// kind of a call from its text, evaluated at compile time by CALL_OPEN_GL
+constexpr auto gl_call_kind(std::string_view call) -> GLCallKind
+{
+    while (!call.empty() && (call.front() == ':' || call.front() == ' ')) { call.remove_prefix(1); }
+
+    constexpr auto draws = std::to_array<std::string_view>({"glDraw", "glMultiDraw"});
+    constexpr auto uploads = std::to_array<std::string_view>(
+        {"glBufferData",
+         "glBufferSubData",
+         "glNamedBufferData",
+         "glNamedBufferSubData",
+         "glTexImage",
+         "glTexSubImage",
+         "glTextureSubImage",
+         "glCompressedTex"});
+    constexpr auto states = std::to_array<std::string_view>(
+        {"glBind",
+         "glUseProgram",
+         "glActiveTexture",
+         "glEnable",
+         "glDisable",
+         "glBlend",
+         "glDepth",
+         "glCullFace",
+         "glPolygonMode",
+         "glViewport",
+         "glScissor",
+         "glClearColor",
+         "glPixelStore",
+         "glUniform",
+         "glTexParameter",
+         "glVertexAttribPointer"});
+
+    const auto starts_with_any = [call](const auto &prefixes) {
+        for (const auto &prefix : prefixes) {
+            if (call.starts_with(prefix)) { return true; }
+        }
+        return false;
+    };
+
+    if (starts_with_any(draws)) { return GLCallKind::DRAW; }
+    if (starts_with_any(uploads)) { return GLCallKind::UPLOAD; }
+    if (starts_with_any(states)) { return GLCallKind::STATE; }
+    return GLCallKind::OTHER;
+}
+
+/// Every GL call made through CALL_OPEN_GL goes through this layer, which counts the calls of the frame and checks
+/// the errors according to the mode selected at runtime.
+class GLLayer {
+public:
+    enum class ErrorCheck {
+        OFF,
+        // glGetError after every call, serialize the driver
+        PER_CALL,
+        // glGetError once at the end of the frame, the call in error is not known
+        PER_FRAME,
+        // only the errors reported by the debug output callback
+        KHR_DEBUG,
+    };
+
+    struct Counters {
+        std::uint64_t calls{0};
+        std::uint64_t draw_calls{0};
+        std::uint64_t state_changes{0};
+        std::uint64_t uploads{0};
+        std::uint64_t upload_bytes{0};
+        /// found by glGetError, on the render context or the upload one
+        std::uint64_t errors{0};
+        /// reported by the debug output callback
+        std::uint64_t callback_errors{0};
+    };
+
+    static auto get() noexcept -> GLLayer &
+    {
+        static GLLayer instance;
+        return instance;
+    }
+
+    template<GLCallKind Kind>
+    auto after_call(const char *call, const char *file, int line) noexcept -> void
+    {
+        if (t_background) {
+            after_background_call<Kind>(call, file, line);
+            return;
+        }
+
+        m_current.calls++;
+        if constexpr (Kind == GLCallKind::DRAW) {
+            m_current.draw_calls++;
+        } else if constexpr (Kind == GLCallKind::STATE) {
+            m_current.state_changes++;
+        } else if constexpr (Kind == GLCallKind::UPLOAD) {
+            m_current.uploads++;
+        }
+
+        if (m_mode == ErrorCheck::PER_CALL) { check(call, file, line); }
+    }
+
+    auto add_upload_bytes(std::size_t bytes) noexcept -> void
+    {
+        if (t_background) {
+            m_background.upload_bytes += bytes;
+        } else {
+            m_current.upload_bytes += bytes;
+        }
+    }
+
+    /// the calls of the current thread are counted apart and added to the frame ending after them
+    // note : for a thread with its own shared context, e.g. the upload thread
+    static auto setBackgroundThread() noexcept -> void { t_background = true; }
+
+    /// check the errors of the background thread, the equivalent of `end_frame` for its context
+    auto end_background_batch() noexcept -> void;
+
+    /// install the debug output callback, the context must be current
+    auto init() -> void;
+
+    /// check the errors of the frame if needed and reset the counters
+    auto end_frame() noexcept -> void;
+
+    /// apply `mode` to the context of the calling thread, the other contexts must `applyErrorCheck` on theirs
+    auto setErrorCheck(ErrorCheck mode) -> void;
+    /// enable the debug output of the context of the calling thread if the current mode needs it
+    auto applyErrorCheck() -> void;
+    auto getErrorCheck() const noexcept -> ErrorCheck { return m_mode.load(); }
+
+    /// counters of the last complete frame
+    auto getLastFrame() const noexcept -> const Counters & { return m_last; }
+
+private:
+    struct BackgroundCounters {
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> state_changes{0};
+        std::atomic<std::uint64_t> uploads{0};
+        std::atomic<std::uint64_t> upload_bytes{0};
+        std::atomic<std::uint64_t> errors{0};
+    };
+
+#ifdef NDEBUG
+    std::atomic<ErrorCheck> m_mode{ErrorCheck::PER_FRAME};
+#else
+    std::atomic<ErrorCheck> m_mode{ErrorCheck::PER_CALL};
+#endif
+    Counters m_current;
+    Counters m_last;
+    BackgroundCounters m_background;
+    // note : the debug output callback may be called from a driver thread
+    std::atomic<std::uint64_t> m_callback_errors{0};
+
+    static inline thread_local bool t_background{false};
+
+    template<GLCallKind Kind>
+    auto after_background_call(const char *call, const char *file, int line) noexcept -> void
+    {
+        m_background.calls++;
+        if constexpr (Kind == GLCallKind::STATE) {
+            m_background.state_changes++;
+        } else if constexpr (Kind == GLCallKind::UPLOAD) {
+            m_background.uploads++;
+        }
+
+        if (m_mode == ErrorCheck::PER_CALL) { check(call, file, line); }
+    }
+
+    auto check(const char *call, const char *file, int line) noexcept -> void;
+};
+
+} // namespace kawe
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "helpers/macro.hpp"
+
+namespace kawe {
+
+/// Last GL state set through it, the calls that would not change anything are skipped.
+/// Once something else may have changed the state behind its back (e.g. the ImGui backend), `invalidate` it.
+class GLState {
+public:
+    static constexpr std::size_t MAX_TEXTURE_UNITS = 16;
+    static constexpr auto TEXTURE_TARGETS = std::to_array<GLenum>({GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY});
+    static constexpr auto CAPABILITIES = std::to_array<GLenum>({GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE});
+
+    GLState() { invalidate(); }
+
+    auto useProgram(GLuint program) -> void
+    {
+        if (!changed(m_program, program)) { return; }
+        CALL_OPEN_GL(::glUseProgram(program));
+    }
+
+    auto bindVertexArray(GLuint vao) -> void
+    {
+        if (!changed(m_vertex_array, vao)) { return; }
+        CALL_OPEN_GL(::glBindVertexArray(vao));
+    }
+
+    /// the units from MAX_TEXTURE_UNITS and the other targets are bound without being cached
+    auto bindTexture(GLenum target, GLuint texture, std::size_t unit = 0) -> void
+    {
+        if (const auto index = index_of(TEXTURE_TARGETS, target);
+            index != TEXTURE_TARGETS.size() && unit < MAX_TEXTURE_UNITS && !changed(m_textures[unit][index], texture)) {
+            return;
+        }
+        activeTexture(unit);
+        CALL_OPEN_GL(::glBindTexture(target, texture));
+    }
+
+    auto setCapability(GLenum capability, bool enabled) -> void
+    {
+        if (const auto index = index_of(CAPABILITIES, capability);
+            index != CAPABILITIES.size() && !changed(m_capabilities[index], static_cast<std::uint32_t>(enabled))) {
+            return;
+        }
+        if (enabled) {
+            CALL_OPEN_GL(::glEnable(capability));
+        } else {
+            CALL_OPEN_GL(::glDisable(capability));
+        }
+    }
+
+    auto blendFunc(GLenum source, GLenum destination) -> void
+    {
+        if (!changed(m_blend_func, {source, destination})) { return; }
+        CALL_OPEN_GL(::glBlendFunc(source, destination));
+    }
+
+    auto viewport(GLint x, GLint y, GLsizei width, GLsizei height) -> void
+    {
+        if (!changed(m_viewport, {x, y, width, height})) { return; }
+        CALL_OPEN_GL(::glViewport(x, y, width, height));
+    }
+
+    auto clearColor(float r, float g, float b, float a) -> void
+    {
+        if (!changed(m_clear_color, {r, g, b, a})) { return; }
+        CALL_OPEN_GL(::glClearColor(r, g, b, a));
+    }
+
+    /// a deleted object is unbound by GL and its name can be reused, so the cache must forget it
+    auto forgetVertexArray(GLuint vao) noexcept -> void
+    {
+        if (m_vertex_array == vao) { m_vertex_array = UNKNOWN; }
+    }
+
+    auto forgetTexture(GLuint texture) noexcept -> void
+    {
+        for (auto &unit : m_textures) {
+            for (auto &bound : unit) {
+                if (bound == texture) { bound = UNKNOWN; }
+            }
+        }
+    }
+
+    auto invalidate() noexcept -> void
+    {
+        m_program = UNKNOWN;
+        m_vertex_array = UNKNOWN;
+        m_active_unit = UNKNOWN;
+        for (auto &unit : m_textures) { unit.fill(UNKNOWN); }
+        m_capabilities.fill(UNKNOWN);
+        m_blend_func.fill(UNKNOWN);
+        m_viewport.fill(-1);
+        // note : a negative color can not be set, so it never matches the current one
+        m_clear_color.fill(-1.0f);
+    }
+
+    /// number of calls skipped since the cache has been created
+    auto getSkippedCount() const noexcept -> std::uint64_t { return m_skipped; }
+
+private:
+    static constexpr auto UNKNOWN = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t m_program{UNKNOWN};
+    std::uint32_t m_vertex_array{UNKNOWN};
+    std::uint32_t m_active_unit{UNKNOWN};
+    std::array<std::array<std::uint32_t, TEXTURE_TARGETS.size()>, MAX_TEXTURE_UNITS> m_textures{};
+    std::array<std::uint32_t, CAPABILITIES.size()> m_capabilities{};
+    std::array<GLenum, 2> m_blend_func{};
+    std::array<GLint, 4> m_viewport{};
+    std::array<float, 4> m_clear_color{};
+
+    std::uint64_t m_skipped{0};
+
+    template<typename T>
+    auto changed(T &current, const T &value) noexcept -> bool
+    {
+        if (current == value) {
+            m_skipped++;
+            return false;
+        }
+        current = value;
+        return true;
+    }
+
+    auto activeTexture(std::size_t unit) -> void
+    {
+        if (!changed(m_active_unit, static_cast<std::uint32_t>(unit))) { return; }
+        CALL_OPEN_GL(::glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + unit)));
+    }
+
+    template<std::size_t N>
+    static constexpr auto index_of(const std::array<GLenum, N> &values, GLenum value) noexcept -> std::size_t
+    {
+        for (std::size_t i = 0; i != N; i++) {
+            if (values[i] == value) { return i; }
+        }
+        return N;
+    }
+};
+
+} // namespace kawe
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "graphics/deps.hpp"
+
+namespace kawe {
+
+/// Thread owning a second GL context, sharing its objects with the render context, which runs the uploads.
+/// A job is given the data it uploads and fills GL objects created beforehand, once the GPU has executed a batch of
+/// jobs a fence is signaled and their `done` callbacks are run by the render thread in `update`, only then the
+/// objects can be used to draw.
+/// Without an upload context (e.g. it could not be created), the jobs are run at once on the render context.
+class GLUploader {
+public:
+    /// run on the upload thread, its context current
+    using Job = std::function<void()>;
+    /// run on the render thread, once the uploads of the job are visible to it
+    using Done = std::function<void()>;
+
+    GLUploader() = default;
+    ~GLUploader() { stop(); }
+
+    GLUploader(const GLUploader &) = delete;
+    auto operator=(const GLUploader &) -> GLUploader & = delete;
+
+    /// create the upload context sharing the objects of `shared` and start the thread, on the main thread
+    // note : GLFW only creates windows on the main thread, the context is made current on the upload thread after
+    auto start(GLFWwindow *shared) -> bool;
+
+    /// drop the jobs not run yet and destroy the upload context, before GLFW is terminated
+    auto stop() -> void;
+
+    auto submit(Job job, Done done) -> void;
+
+    /// apply the mode of the GLLayer to the upload context, once it has been changed on the render context
+    auto applyErrorCheck() -> void;
+
+    /// run the `done` callbacks of the batches the GPU has finished, the render context must be current
+    auto update() -> void;
+
+    auto isThreaded() const noexcept -> bool { return m_window != nullptr; }
+
+    /// number of jobs whose `done` has not been run yet
+    auto getPendingCount() const noexcept -> std::size_t { return m_pending; }
+
+private:
+    struct Task {
+        Job job;
+        Done done;
+    };
+
+    struct Batch {
+        GLsync fence;
+        std::vector<Done> done;
+    };
+
+    GLFWwindow *m_window{nullptr};
+    std::thread m_thread;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<Task> m_tasks;
+    // note : the batches run by the upload thread, in order, their fences may not be signaled yet
+    std::deque<Batch> m_batches;
+    bool m_stop{false};
+
+    std::size_t m_pending{0};
+
+    auto run() -> void;
+};
+
+} // namespace kawe
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+#include "helpers/macro.hpp"
+#include "graphics/GLUploader.hpp"
+
+namespace kawe {
+
+/// GL buffers shared between the entities uploading the same content.
+/// A buffer is created on the first `acquire` of its content and deleted when the last user `release` it, so the VRAM
+/// used is proportional to the unique geometry. It is uploaded by the upload thread, and must not be drawn before
+/// `isReady`, then only once it has been bound again on the render context (see `Render::attach`).
+/// A content owned by a `storage`, e.g. a mapped file, is identified by where it is in it, it is neither hashed nor
+/// copied. Any other content is identified by its hash then compared to the contents having the same, it is copied
+/// unless its owner gives it along with its hashed key (see `Render::VBO::emplace`).
+class GpuBufferCache {
+public:
+    struct Key {
+        GLenum target;
+        std::size_t bytes;
+        /// the storage of the content, null for a content identified by its hash
+        const void *storage;
+        /// the address of the content in its storage, or the hash of the content without one
+        std::size_t identity;
+
+        auto operator==(const Key &) const noexcept -> bool = default;
+    };
+
+    template<typename T>
+    static auto key_of(GLenum target, std::span<const T> content, const void *storage = nullptr) noexcept -> Key
+    {
+        const auto bytes = content.size_bytes();
+        if (storage != nullptr) { return {target, bytes, storage, reinterpret_cast<std::uintptr_t>(content.data())}; }
+        return {
+            target,
+            bytes,
+            nullptr,
+            std::hash<std::string_view>{}(std::string_view{reinterpret_cast<const char *>(content.data()), bytes})};
+    }
+
+    explicit GpuBufferCache(GLUploader &uploader) : m_uploader{uploader} {}
+    ~GpuBufferCache();
+
+    GpuBufferCache(const GpuBufferCache &) = delete;
+    auto operator=(const GpuBufferCache &) -> GpuBufferCache & = delete;
+
+    /// the buffer which will hold `content`, left bound to `target`, `storage` keeps `content` alive if given
+    // note : binding an element array buffer records it in the bound vertex array, bind the right one before
+    template<typename T>
+    auto acquire(GLenum target, std::span<const T> content, std::shared_ptr<const void> storage = nullptr) -> GLuint
+    {
+        // note : the key is made before `storage` is moved, the arguments may be evaluated in any order
+        const auto key = key_of(target, content, storage.get());
+        return acquire(key, content.data(), std::move(storage));
+    }
+
+    /// `data` is copied without a `storage` keeping it alive, whatever the kind of `key`
+    auto acquire(const Key &key, const void *data, std::shared_ptr<const void> storage = nullptr) -> GLuint;
+
+    /// drop a reference on a buffer given by `acquire`, deleted with the last one
+    auto release(GLuint buffer) -> void;
+
+    /// the content of the buffer has been uploaded and is visible to the render context
+    auto isReady(GLuint buffer) const noexcept -> bool
+    {
+        const auto found = m_buffers.find(buffer);
+        return found != m_buffers.end() && found->second.ready;
+    }
+
+    auto getBufferCount() const noexcept -> std::size_t { return m_buffers.size(); }
+    /// number of buffers whose content is still uploading
+    auto getPendingCount() const noexcept -> std::size_t { return m_pending; }
+    auto getBytes() const noexcept -> std::size_t { return m_bytes; }
+    /// number of `acquire` which did not need any upload
+    auto getSharedCount() const noexcept -> std::size_t { return m_shared; }
+
+private:
+    struct KeyHash {
+        auto operator()(const Key &key) const noexcept -> std::size_t
+        {
+            return key.identity ^ (std::hash<std::size_t>{}(key.bytes) << 1)
+                   ^ (static_cast<std::size_t>(key.target) << 2);
+        }
+    };
+
+    struct Buffer {
+        Key key;
+        /// the content, kept to be compared with the contents having the same hash
+        const void *data;
+        std::shared_ptr<const void> storage;
+        std::size_t refs;
+        bool ready;
+    };
+
+    GLUploader &m_uploader;
+    // note : different contents without storage may have the same key, they are told apart by `Buffer::data`
+    std::unordered_multimap<Key, GLuint, KeyHash> m_objects;
+    std::unordered_map<GLuint, Buffer> m_buffers;
+    std::size_t m_bytes{0};
+    std::size_t m_shared{0};
+    std::size_t m_pending{0};
+
+    auto find(const Key &key, const void *data) const -> std::optional<GLuint>;
+    auto on_uploaded(GLuint buffer) -> void;
+};
+
+} // namespace kawe
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <optional>
+
+#include "helpers/macro.hpp"
+#include "FrameStats.hpp"
+
+namespace kawe {
+
+/// GL_TIME_ELAPSED queries around the render passes.
+/// Every pass owns a ring of queries, a result is read back `LATENCY - 1` frames after being issued so reading it
+/// never waits for the GPU. The results are added to the frame stats as `gpu <pass>` sections.
+class GpuTimers {
+public:
+    enum class Pass { SCENE, PICKING, IMGUI };
+
+    static constexpr std::size_t PASS_COUNT = 3;
+    static constexpr std::size_t LATENCY = 4;
+    static constexpr std::array<const char *, PASS_COUNT> SECTION_NAMES = {"gpu scene", "gpu picking", "gpu imgui"};
+
+    class Scope {
+    public:
+        explicit Scope(GLuint query) : m_query{query} { CALL_OPEN_GL(::glBeginQuery(GL_TIME_ELAPSED, m_query)); }
+        ~Scope() { CALL_OPEN_GL(::glEndQuery(GL_TIME_ELAPSED)); }
+
+        Scope(const Scope &) = delete;
+        auto operator=(const Scope &) -> Scope & = delete;
+
+    private:
+        GLuint m_query;
+    };
+
+    explicit GpuTimers(FrameStats &stats);
+    ~GpuTimers();
+
+    GpuTimers(const GpuTimers &) = delete;
+    auto operator=(const GpuTimers &) -> GpuTimers & = delete;
+
+    /// the passes can not be nested, only one GL_TIME_ELAPSED query may be active at once
+    [[nodiscard]] auto measure(Pass pass) -> Scope;
+
+    /// move to the next slot of the ring, reading back the queries it holds
+    auto end_frame() -> void;
+
+    /// last time read back, empty if the pass never ran
+    auto getLast(Pass pass) const noexcept -> std::optional<std::chrono::nanoseconds>
+    {
+        return m_last[static_cast<std::size_t>(pass)];
+    }
+
+    /// number of results not available in time, dropped instead of stalling
+    auto getLateCount() const noexcept -> std::size_t { return m_late; }
+
+private:
+    struct Slot {
+        std::array<GLuint, PASS_COUNT> queries{};
+        std::array<bool, PASS_COUNT> issued{};
+    };
+
+    FrameStats &m_stats;
+    std::array<Slot, LATENCY> m_slots;
+    std::size_t m_current{0};
+    std::array<std::optional<std::chrono::nanoseconds>, PASS_COUNT> m_last;
+    std::size_t m_late{0};
+};
+
+} // namespace kawe
@@ -90,6 +90,8 @@ public:
 
     auto use() const noexcept -> void { CALL_OPEN_GL(::glUseProgram(program_id)); }
 
+    auto getId() const noexcept -> std::uint32_t { return program_id; }
+
     template<typename T>
     auto setUniform(const std::string_view, T) -> void;
 
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <future>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "helpers/macro.hpp"
+#include "helpers/ThreadPool.hpp"
+#include "graphics/GLState.hpp"
+#include "graphics/GLUploader.hpp"
+#include "binary/TextureFile.hpp"
+
+namespace kawe {
+
+class ResourceLoader;
+
+/// GL textures shared between the entities using the same image.
+/// An image is cooked once to a `.kawetex` file holding its whole mip chain, the next runs map it and upload it as is.
+/// The images of the same size are packed as the layers of a few GL_TEXTURE_2D_ARRAY, so drawing differently skinned
+/// objects does not need to bind another texture, only to change the layer index given to the shader.
+/// The first `acquire` of an image returns at once, the image is cooked or mapped by a worker thread then its levels
+/// are given to the upload thread a few per frame by `update`, a placeholder is drawn meanwhile.
+/// Only the levels needed by the size of the image on screen are resident, see `request`: the image is streamed to
+/// the array of its new top level and the least recently drawn images lose their finest levels to stay in budget.
+/// Its layer is freed when the last user `release` it.
+class TextureCache {
+public:
+    /// index of an image in the cache, stable for as long as it is acquired
+    using Handle = std::uint32_t;
+    static constexpr auto NONE = std::numeric_limits<Handle>::max();
+
+    /// what to bind to draw an image
+    struct Binding {
+        GLuint object;
+        std::uint32_t layer;
+    };
+
+    static constexpr std::uint32_t INITIAL_LAYERS = 4;
+    // note : the minimum value of GL_MAX_ARRAY_TEXTURE_LAYERS in OpenGL 4.5
+    static constexpr std::uint32_t MAX_LAYERS = 2048;
+
+    static constexpr auto DIRECTORY = "cache/textures";
+
+    static constexpr std::size_t DEFAULT_UPLOAD_BUDGET = 8 * 1024 * 1024;
+    static constexpr std::size_t DEFAULT_BUDGET = 512 * 1024 * 1024;
+    /// the levels up to this size are always resident, they are first uploaded and never evicted
+    static constexpr std::uint32_t MIN_RESIDENT_SIZE = 64;
+
+    TextureCache(ResourceLoader &loader, GLState &state, GLUploader &uploader) :
+        m_loader{loader}, m_state{state}, m_uploader{uploader}
+    {
+    }
+    ~TextureCache();
+
+    TextureCache(const TextureCache &) = delete;
+    auto operator=(const TextureCache &) -> TextureCache & = delete;
+
+    /// the image at `filepath`, loaded in the background the first time
+    auto acquire(const std::string &filepath) -> Handle;
+
+    /// drop a reference on an image, its layer is freed with the last one
+    auto release(Handle image) -> void;
+
+    /// the image is drawn this frame about `pixels` wide, the finest level needed by its users is streamed in
+    auto request(Handle image, double pixels) -> void;
+
+    /// stream the images requested since the last call and submit their uploads, within the budget of the frame
+    auto update() -> void;
+
+    /// the layer of the image, or the placeholder until it is uploaded or if it failed to load
+    /// note : the array texture changes when it grows or the image is streamed, do not keep it across frames
+    auto getBinding(Handle image) -> Binding;
+
+    auto getUploadBudget() const noexcept -> std::size_t { return m_upload_budget; }
+    /// bytes submitted to the upload thread per frame, at least one level is submitted each frame whatever its size
+    auto setUploadBudget(std::size_t bytes) noexcept -> void { m_upload_budget = bytes; }
+
+    auto getBudget() const noexcept -> std::size_t { return m_budget; }
+    /// bytes of the resident levels, the finest levels of the least recently drawn images are evicted above it
+    // note : the levels always resident are not counted out, they may exceed a too small budget
+    auto setBudget(std::size_t bytes) noexcept -> void { m_budget = bytes; }
+
+    auto getPoolCount() const noexcept -> std::size_t { return m_pool_count; }
+    auto getTextureCount() const noexcept -> std::size_t { return m_paths.size(); }
+    /// number of images still loading or streaming
+    auto getPendingCount() const noexcept -> std::size_t { return m_pending.size(); }
+    /// bytes of the arrays, free layers included
+    auto getBytes() const noexcept -> std::size_t { return m_bytes; }
+    /// bytes of the levels resident or being streamed in, the ones counted against the budget
+    auto getResidentBytes() const noexcept -> std::size_t { return m_resident_bytes; }
+    /// number of `acquire` which did not need any upload
+    auto getSharedCount() const noexcept -> std::size_t { return m_shared; }
+    /// number of images which lost levels to stay in budget
+    auto getEvictedCount() const noexcept -> std::size_t { return m_evicted; }
+
+private:
+    struct Pool {
+        GLuint object{0};
+        GLsizei width{0};
+        GLsizei height{0};
+        GLsizei levels{0};
+        GLenum internal_format{GL_RGBA8};
+        std::size_t layer_bytes{0};
+        std::uint32_t capacity{0};
+        std::uint32_t used{0};
+        // note : the array is not grown while the upload thread writes to it
+        std::uint32_t uploading{0};
+        std::vector<std::uint32_t> free_layers;
+    };
+
+    struct Location {
+        std::uint32_t pool;
+        std::uint32_t layer;
+    };
+
+    /// the levels of an image from `level` to 1x1, the base level of the layer is `level` of the image
+    struct Resident {
+        Location location;
+        std::size_t level;
+    };
+
+    struct Image {
+        // note : DROPPED is released while its levels are still uploading, its layers are freed after them
+        enum class State { FREE, LOADING, LOADED, FAILED, DROPPED };
+
+        static constexpr auto NEVER = std::numeric_limits<std::uint64_t>::max();
+
+        std::string filepath;
+        std::size_t refs{0};
+        State state{State::FREE};
+        std::future<std::optional<binary::TextureFile>> loading;
+        // note : kept mapped to stream the levels, shared with the upload jobs reading them
+        std::shared_ptr<const binary::TextureFile> cooked;
+
+        // note : drawn until the streamed levels are uploaded, then replaced by them
+        std::optional<Resident> resident;
+        std::optional<Resident> streaming;
+        std::size_t next_level{0};
+        std::uint32_t uploading{0};
+
+        // note : the finest level requested during `last_used`
+        std::size_t wanted_level{0};
+        std::uint64_t last_used{NEVER};
+    };
+
+    ResourceLoader &m_loader;
+    GLState &m_state;
+    GLUploader &m_uploader;
+#ifdef KAWE_TEXTURE_COMPRESSION
+    binary::TextureFile::Format m_format{binary::TextureFile::Format::BC3};
+#else
+    binary::TextureFile::Format m_format{binary::TextureFile::Format::RGBA8};
+#endif
+
+    std::vector<Pool> m_pools;
+    std::size_t m_pool_count{0};
+    std::vector<Image> m_images;
+    std::vector<Handle> m_free_images;
+    std::unordered_map<std::string, Handle> m_paths;
+    std::vector<Handle> m_pending;
+    std::size_t m_bytes{0};
+    std::size_t m_resident_bytes{0};
+    std::size_t m_shared{0};
+    std::size_t m_evicted{0};
+    std::uint64_t m_frame{0};
+
+    std::size_t m_upload_budget{DEFAULT_UPLOAD_BUDGET};
+    std::size_t m_budget{DEFAULT_BUDGET};
+    GLuint m_placeholder{0};
+
+    // note : the last member, the workers are stopped before anything they use is destroyed
+    ThreadPool m_workers{"texture loader"};
+
+    /// the cooked image at `filepath`, cooked first if needed, run by the workers
+    auto cook(const std::string &filepath) const -> std::optional<binary::TextureFile>;
+
+    /// the level the image should have resident now, the coarsest one if it has not been drawn lately
+    auto target_level(const Image &image) const noexcept -> std::size_t;
+    /// evict levels of the least recently drawn images until `bytes` more fit in the budget
+    auto make_room(std::size_t bytes, Handle except) -> bool;
+    /// start uploading the levels of an image from `level` to a new layer
+    auto stream(Handle handle, std::size_t level) -> void;
+
+    /// submit the upload of the next level of a streamed image, return its number of bytes
+    auto upload_level(Handle handle) -> std::size_t;
+    auto on_uploaded(Handle handle, std::uint32_t pool) -> void;
+
+    auto free_layer(const Location &location) -> void;
+    auto find_layer(binary::TextureFile::Format format, std::span<const binary::TextureFile::Level> levels)
+        -> Location;
+    auto grow(Pool &pool, std::uint32_t capacity) -> void;
+
+    /// the coarsest level always resident
+    static auto coarsest_level(std::span<const binary::TextureFile::Level> levels) noexcept -> std::size_t;
+    static auto bytes_from(std::span<const binary::TextureFile::Level> levels, std::size_t level) noexcept
+        -> std::size_t;
+};
+
+} // namespace kawe
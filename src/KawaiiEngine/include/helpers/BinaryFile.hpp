@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace kawe {
+
+/// Little endian fields and crash safe writes, shared by the cooked file formats.
+struct BinaryFile {
+    /// write the `size` low bytes of `value` at `offset`
+    static auto put(std::vector<std::uint8_t> &out, std::size_t offset, std::uint64_t value, std::size_t size) noexcept
+        -> void
+    {
+        for (std::size_t i = 0; i != size; i++) { out[offset + i] = static_cast<std::uint8_t>(value >> (8u * i)); }
+    }
+
+    static auto get(std::span<const std::uint8_t> in, std::size_t offset, std::size_t size) noexcept -> std::uint64_t
+    {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i != size; i++) { value |= std::uint64_t{in[offset + i]} << (8u * i); }
+        return value;
+    }
+
+    /// write `bytes` through a temporary file renamed over `path`, so a crash never leaves a truncated one
+    static auto save(const std::filesystem::path &path, std::span<const std::uint8_t> bytes) -> bool;
+};
+
+} // namespace kawe
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace kawe {
+
+/// Small LZ77 block codec (LZ4 like sequences), fast enough to run on every block of a log.
+
+/// append the compressed `in` to `out`
+auto compress_block(std::span<const std::uint8_t> in, std::vector<std::uint8_t> &out) -> void;
+
+/// `out` must be exactly the size of the uncompressed block, return false if `in` is corrupted
+auto decompress_block(std::span<const std::uint8_t> in, std::span<std::uint8_t> out) noexcept -> bool;
+
+} // namespace kawe
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace kawe {
+
+/// 64 bits FNV-1a, stable across platforms and runs so it can name files on disk
+constexpr auto fnv1a(std::span<const std::uint8_t> bytes, std::uint64_t hash = 0xCBF29CE484222325ull) noexcept
+    -> std::uint64_t
+{
+    for (const auto byte : bytes) {
+        hash ^= byte;
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+} // namespace kawe
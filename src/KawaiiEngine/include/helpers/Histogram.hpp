@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace kawe {
+
+/// Log-linear histogram of unsigned values, in the spirit of HdrHistogram.
+/// Every power of two range is split into `2^SubBucketBits` buckets, so the relative error of a percentile is
+/// below `2^-SubBucketBits` whatever the magnitude. The storage is fixed, recording never allocates.
+template<std::size_t SubBucketBits = 6, std::size_t MaxValueBits = 40>
+class Histogram {
+    static_assert(SubBucketBits < MaxValueBits && MaxValueBits < 64);
+
+public:
+    static constexpr std::uint64_t SUB_BUCKET_COUNT = std::uint64_t{1} << SubBucketBits;
+    static constexpr std::size_t BUCKET_COUNT = (MaxValueBits - SubBucketBits + 1) * SUB_BUCKET_COUNT;
+    static constexpr std::uint64_t MAX_VALUE = (std::uint64_t{1} << MaxValueBits) - 1;
+
+    /// values above MAX_VALUE are counted in the last bucket, `max()` stays exact
+    auto record(std::uint64_t value) noexcept -> void
+    {
+        m_counts[index_of(std::min(value, MAX_VALUE))]++;
+        m_count++;
+        m_sum += value;
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+
+    /// smallest recorded value `v` such as `q` of the values are lower or equal, `q` between 0 and 1
+    auto percentile(double q) const noexcept -> std::uint64_t
+    {
+        if (m_count == 0) { return 0; }
+
+        const auto rank = std::max<std::uint64_t>(
+            1, static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(m_count))));
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i != BUCKET_COUNT; i++) {
+            seen += m_counts[i];
+            if (seen >= rank) { return std::clamp(upper_bound_of(i), m_min, m_max); }
+        }
+        return m_max;
+    }
+
+    auto count() const noexcept -> std::uint64_t { return m_count; }
+    auto min() const noexcept -> std::uint64_t { return m_count == 0 ? 0 : m_min; }
+    auto max() const noexcept -> std::uint64_t { return m_max; }
+
+    auto mean() const noexcept -> double
+    {
+        return m_count == 0 ? 0.0 : static_cast<double>(m_sum) / static_cast<double>(m_count);
+    }
+
+    auto reset() noexcept -> void { *this = {}; }
+
+    static constexpr auto index_of(std::uint64_t value) noexcept -> std::size_t
+    {
+        if (value < SUB_BUCKET_COUNT) { return value; }
+
+        // note : the `SubBucketBits` bits below the highest one select the bucket inside the power of two range
+        const auto shift = std::bit_width(value) - 1 - SubBucketBits;
+        return (shift + 1) * SUB_BUCKET_COUNT + ((value >> shift) - SUB_BUCKET_COUNT);
+    }
+
+    static constexpr auto upper_bound_of(std::size_t index) noexcept -> std::uint64_t
+    {
+        if (index < SUB_BUCKET_COUNT) { return index; }
+
+        const auto shift = index / SUB_BUCKET_COUNT - 1;
+        const auto sub_bucket = index % SUB_BUCKET_COUNT;
+        return ((SUB_BUCKET_COUNT + sub_bucket) << shift) + ((std::uint64_t{1} << shift) - 1);
+    }
+
+private:
+    std::array<std::uint64_t, BUCKET_COUNT> m_counts{};
+    std::uint64_t m_count{0};
+    std::uint64_t m_sum{0};
+    std::uint64_t m_min{std::numeric_limits<std::uint64_t>::max()};
+    std::uint64_t m_max{0};
+};
+
+} // namespace kawe
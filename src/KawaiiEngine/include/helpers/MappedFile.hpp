@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace kawe {
+
+/// Read only memory mapping of a whole file.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    auto operator=(const MappedFile &) -> MappedFile & = delete;
+
+    MappedFile(MappedFile &&other) noexcept;
+    auto operator=(MappedFile &&other) noexcept -> MappedFile &;
+
+    auto is_open() const noexcept -> bool { return m_data != nullptr; }
+
+    auto data() const noexcept -> const std::uint8_t * { return m_data; }
+    auto size() const noexcept -> std::size_t { return m_size; }
+
+    auto bytes() const noexcept -> std::span<const std::uint8_t> { return {m_data, m_size}; }
+
+private:
+    const std::uint8_t *m_data{nullptr};
+    std::size_t m_size{0};
+
+#ifdef _WIN32
+    void *m_file{nullptr};
+    void *m_mapping{nullptr};
+#endif
+
+    auto release() noexcept -> void;
+};
+
+} // namespace kawe
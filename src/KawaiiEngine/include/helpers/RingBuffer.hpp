@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <optional>
+
+namespace kawe {
+
+/// Fixed capacity single producer / single consumer queue.
+/// `push` may be called from one thread while `front`, `pop` and `try_pop` are called from another one.
+template<typename T, std::size_t Capacity>
+class RingBuffer {
+    static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    /// producer side, return false if the buffer is full
+    template<typename... Args>
+    auto push(Args &&... args) -> bool
+    {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == Capacity) { return false; }
+
+        m_data[head & MASK] = T{std::forward<Args>(args)...};
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// consumer side, the element stays valid until the next `pop`
+    auto front() noexcept -> T *
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) { return nullptr; }
+        return &m_data[tail & MASK];
+    }
+
+    /// consumer side, must only be called if `front` returned an element
+    auto pop() noexcept -> void { m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    auto try_pop() -> std::optional<T>
+    {
+        const auto value = front();
+        if (value == nullptr) { return {}; }
+        auto out = std::optional<T>{std::move(*value)};
+        pop();
+        return out;
+    }
+
+    /// consumer side
+    auto clear() noexcept -> void { m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release); }
+
+    auto size() const noexcept -> std::size_t
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    auto empty() const noexcept -> bool { return size() == 0; }
+
+    static constexpr auto capacity() noexcept -> std::size_t { return Capacity; }
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+    // note : keep the indexes on their own cache line so the producer and the consumer don t fight for it
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> m_head{0};
+    alignas(CACHE_LINE) std::atomic<std::size_t> m_tail{0};
+    alignas(CACHE_LINE) std::array<T, Capacity> m_data{};
+};
+
+} // namespace kawe
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Profiler.hpp"
+
+namespace kawe {
+
+/// Fixed set of worker threads running the submitted jobs in order.
+/// The jobs still queued when the pool is destroyed are dropped, their future reports a broken promise.
+class ThreadPool {
+public:
+    explicit ThreadPool(const std::string &name, std::size_t count = default_count())
+    {
+        for (std::size_t i = 0; i != count; i++) {
+            m_workers.emplace_back([this, thread_name = fmt::format("{} #{}", name, i)] {
+                Profiler::get().setThreadName(thread_name);
+                run();
+            });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lock{m_mutex};
+            m_stop = true;
+            m_jobs.clear();
+        }
+        m_wake.notify_all();
+        for (auto &worker : m_workers) { worker.join(); }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+    template<typename F>
+    [[nodiscard]] auto submit(F &&job) -> std::future<std::invoke_result_t<F>>
+    {
+        // note : std::function needs a copyable callable, the task is shared
+        auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(job));
+        auto future = task->get_future();
+        {
+            std::lock_guard lock{m_mutex};
+            m_jobs.emplace_back([task] { (*task)(); });
+        }
+        m_wake.notify_one();
+        return future;
+    }
+
+    /// one thread is left to the main loop
+    static auto default_count() noexcept -> std::size_t
+    {
+        const auto cores = std::size_t{std::thread::hardware_concurrency()};
+        return cores > 1 ? cores - 1 : 1;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<std::function<void()>> m_jobs;
+    bool m_stop{false};
+    std::vector<std::thread> m_workers;
+
+    auto run() -> void
+    {
+        while (true) {
+            std::function<void()> job;
+            {
+                std::unique_lock lock{m_mutex};
+                m_wake.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+                if (m_stop) { return; }
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+            job();
+        }
+    }
+};
+
+} // namespace kawe
@@ -1,55 +1,25 @@
 #pragma once
 
 #include <GL/glew.h>
-
-#ifndef NDEBUG
-
-#    include <stdexcept>
-// #    include <source_location>
-#    include <spdlog/spdlog.h>
-
-namespace kawe {
-
-inline constexpr auto GetGLErrorStr(GLenum err)
-{
-    switch (err) {
-    case GL_NO_ERROR: return "OPEN_GL: No error";
-    case GL_INVALID_ENUM: return "OPEN_GL: Invalid enum";
-    case GL_INVALID_VALUE: return "OPEN_GL: Invalid value";
-    case GL_INVALID_OPERATION: return "OPEN_GL: Invalid operation";
-    case GL_STACK_OVERFLOW: return "OPEN_GL: Stack overflow";
-    case GL_STACK_UNDERFLOW: return "OPEN_GL: Stack underflow";
-    case GL_OUT_OF_MEMORY: return "OPEN_GL: Out of memory";
-    default: return "OPEN_GL: Unknown error";
-    }
-}
-
-} // namespace kawe
-
-#    define SHOW_ERROR(err)                                                                            \
-        do {                                                                                           \
-            spdlog::error("CALL_OPEN_GL: {} at {}: {}", kawe::GetGLErrorStr(err), __FILE__, __LINE__); \
-        } while (0)
-
-#    define CALL_OPEN_GL(call)                                          \
-        do {                                                            \
-            call;                                                       \
-            if (const auto err = ::glGetError(); GL_NO_ERROR != err) {  \
-                if constexpr (!noexcept(__func__)) {                    \
-                    throw std::runtime_error(kawe::GetGLErrorStr(err)); \
-                } else {                                                \
-                    SHOW_ERROR(err);                                    \
-                }                                                       \
-            }                                                           \
-        } while (0)
-
-#else
-
-#    define SHOW_ERROR(err)
-
-#    define CALL_OPEN_GL(call) \
-        do {                   \
-            call;              \
-        } while (0)
-
-#endif
+#include <spdlog/spdlog.h>
+
+#include "graphics/GLLayer.hpp"
+
+#define SHOW_ERROR(err)                                                                            \
+    do {                                                                                           \
+        spdlog::error("CALL_OPEN_GL: {} at {}: {}", kawe::GetGLErrorStr(err), __FILE__, __LINE__); \
+    } while (0)
+
+// note : the kind of the call is deduced from its text at compile time, the layer counts it and checks the errors
+//        according to the mode selected at runtime, see kawe::GLLayer
+#define CALL_OPEN_GL(call)                                                                                     \
+    do {                                                                                                       \
+        call;                                                                                                  \
+        ::kawe::GLLayer::get().after_call<::kawe::gl_call_kind(#call)>(#call, __FILE__, __LINE__);             \
+    } while (0)
+
+#define CALL_OPEN_GL_UPLOAD(call, bytes)                                                                       \
+    do {                                                                                                       \
+        CALL_OPEN_GL(call);                                                                                    \
+        ::kawe::GLLayer::get().add_upload_bytes(bytes);                                                        \
+    } while (0)
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "EventSource.hpp"
+
+namespace kawe {
+
+/// Decode a json array of events with a SAX parser running on a background thread.
+/// Only one array element is held as a json value at a time, the decoded events are handed over in chunks
+/// and the parser waits when the player is too far behind, so the memory used does not depend on the file size.
+class JsonEventReader final : public EventSource {
+public:
+    explicit JsonEventReader(std::filesystem::path path);
+    ~JsonEventReader() override;
+
+    JsonEventReader(const JsonEventReader &) = delete;
+    auto operator=(const JsonEventReader &) -> JsonEventReader & = delete;
+
+    auto is_open() const noexcept -> bool { return m_valid; }
+
+    /// wait for the parser if the next chunk is not decoded yet
+    auto next() -> std::optional<event::Event> override;
+
+    auto remaining() const noexcept -> std::size_t override { return size() - m_position; }
+
+    /// number of events decoded until now, it grows while the file is parsed
+    auto size() const noexcept -> std::size_t override;
+
+    /// restart the parser from the start of the file, skipping the events before `index`
+    auto seek(std::size_t index) -> bool override;
+
+    auto is_parsing() const noexcept -> bool;
+
+private:
+    static constexpr std::size_t CHUNK_SIZE = 1024;
+    static constexpr std::size_t MAX_PENDING_CHUNKS = 8;
+
+    std::filesystem::path m_path;
+    bool m_valid{false};
+
+    // player side
+    std::vector<event::Event> m_chunk;
+    std::size_t m_chunk_cursor{0};
+    std::size_t m_position{0};
+
+    // shared
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::vector<event::Event>> m_chunks;
+    std::size_t m_parsed{0};
+    bool m_done{false};
+    bool m_stop{false};
+
+    std::thread m_parser;
+
+    auto start(std::size_t skip) -> void;
+    auto stop() -> void;
+    auto run(std::size_t skip) -> void;
+};
+
+} // namespace kawe
@@ -21,7 +21,7 @@ struct adl_serializer<Joystick::Axis> {
 
     static void from_json(const nlohmann::json &j, Joystick::Axis &axis)
     {
-        std::string value = j.at("axis");
+        const auto value = j.get<std::string>();
         axis = magic_enum::enum_cast<Joystick::Axis>(value).value_or(Joystick::AXES_MAX);
     }
 };
@@ -35,7 +35,7 @@ struct adl_serializer<Joystick::Buttons> {
 
     static void from_json(const nlohmann::json &j, Joystick::Buttons &button)
     {
-        std::string value = j.at("button");
+        const auto value = j.get<std::string>();
         button = magic_enum::enum_cast<Joystick::Buttons>(value).value_or(Joystick::BUTTONS_MAX);
     }
 };
@@ -49,7 +49,7 @@ struct adl_serializer<Key::Code> {
 
     static void from_json(const nlohmann::json &j, Key::Code &keycode)
     {
-        std::string value = j.at("keycode");
+        const auto value = j.get<std::string>();
         keycode = magic_enum::enum_cast<Key::Code>(value).value_or(Key::Code::KEY_UNKNOWN);
     }
 };
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "resources/ObjMesh.hpp"
+
+namespace kawe {
+
+/// Turn the corners of an obj into indexed streams, then reorder them for the GPU before they are cooked:
+///  - `weld` merges the corners having the same position, normal and texcoord, and only them
+///  - `optimize_vertex_cache` orders the triangles for the post-transform cache (Tipsify, Sander et al. 2007)
+///  - `optimize_overdraw` sorts clusters of these triangles so the outer ones are drawn first, while the cache miss
+///    ratio stays within `OVERDRAW_THRESHOLD` of the previous one
+///  - `optimize_vertex_fetch` orders the vertices as the triangles first use them
+struct MeshOptimizer {
+    struct Mesh {
+        std::vector<float> positions;
+        std::vector<float> normals;
+        std::vector<float> texcoords;
+        std::vector<std::uint32_t> indices;
+
+        auto vertex_count() const noexcept -> std::size_t { return positions.size() / 3; }
+    };
+
+    /// the number of vertices the post-transform cache is assumed to hold
+    static constexpr std::size_t CACHE_SIZE = 16;
+    static constexpr float OVERDRAW_THRESHOLD = 1.05f;
+
+    static auto weld(const ObjMesh &obj) -> Mesh;
+
+    /// reorder the triangles, return the index of the first triangle of each cluster
+    static auto optimize_vertex_cache(std::span<std::uint32_t> indices, std::size_t vertex_count)
+        -> std::vector<std::size_t>;
+
+    /// reorder the clusters given by `optimize_vertex_cache`, split further where the cache allows it
+    static auto optimize_overdraw(
+        std::span<std::uint32_t> indices, std::span<const float> positions, std::span<const std::size_t> clusters)
+        -> void;
+
+    static auto optimize_vertex_fetch(Mesh &mesh) -> void;
+
+    /// all of the above but `weld`
+    static auto optimize(Mesh &mesh) -> void;
+
+    /// the average number of vertices transformed per triangle by a FIFO cache of `cache_size`, from 0.5 to 3
+    static auto
+        acmr(std::span<const std::uint32_t> indices, std::size_t vertex_count, std::size_t cache_size = CACHE_SIZE)
+            -> float;
+};
+
+} // namespace kawe
@@ -1,17 +1,26 @@
 #pragma once
 
-#include <glm/vec2.hpp>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
 #include <glm/vec3.hpp>
-#include <tiny_obj_loader.h>
 
 namespace kawe {
 
+/// a mesh as cooked in its `.kmesh` file, the streams point into `storage`, mapped for as long as the model lives
 struct Model {
-    std::vector<float> vertices;
-    std::vector<float> normals;
-    std::vector<float> texcoords;
-    std::vector<uint32_t> indices;
+    static constexpr auto CACHE_DIRECTORY = "cache/meshes";
+
+    std::span<const float> vertices;
+    std::span<const float> normals;
+    std::span<const float> texcoords;
+    std::span<const std::uint32_t> indices;
+    glm::vec3 min;
+    glm::vec3 max;
     std::string filepath;
+    std::shared_ptr<const void> storage;
 };
 
 } // namespace kawe
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace kawe {
+
+/// The geometry of a Wavefront `.obj` file, as indexed by its faces, the polygons are split in triangle fans.
+/// The file is mapped and split in chunks of whole lines parsed by as many threads, their attributes and faces are then
+/// merged in place in buffers of the exact size, the negative indices being resolved against the previous chunks.
+/// Only `v`, `vt`, `vn` and `f` are read, the other statements (groups, materials, ...) are skipped.
+struct ObjMesh {
+    static constexpr auto NONE = std::numeric_limits<std::uint32_t>::max();
+
+    /// a vertex of a face, the index of each of its attributes, NONE for a texcoord or a normal not given
+    struct Corner {
+        std::uint32_t position;
+        std::uint32_t texcoord;
+        std::uint32_t normal;
+    };
+
+    /// below it, the file is parsed by the calling thread only
+    static constexpr std::size_t MIN_CHUNK_SIZE = 1024 * 1024;
+
+    std::vector<float> positions;
+    std::vector<float> texcoords;
+    std::vector<float> normals;
+    /// three per triangle
+    std::vector<Corner> corners;
+
+    /// parse the file at `filepath` on up to `threads` threads, empty if it can not be read or an index is invalid
+    static auto load(const std::filesystem::path &filepath, std::size_t threads = default_threads())
+        -> std::optional<ObjMesh>;
+
+    static auto default_threads() noexcept -> std::size_t;
+};
+
+} // namespace kawe
@@ -4,6 +4,7 @@
 #include <spdlog/spdlog.h>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/hash.hpp>
@@ -14,6 +15,9 @@
 #include "graphics/Shader.hpp"
 #include "Texture.hpp"
 #include "Model.hpp"
+#include "ObjMesh.hpp"
+#include "MeshOptimizer.hpp"
+#include "binary/MeshFile.hpp"
 
 // ! pain
 // generates a loader class with the specified type and loader function.
@@ -61,71 +65,60 @@ CREATE_LOADER_CLASS(
     })
 
 // creates a model loader.
+// note : an obj is parsed, welded and optimized once and cooked to a `.kmesh` file, the next runs map it and use
+// its streams in place
 CREATE_LOADER_CLASS(
     Model, auto load(const std::string &filepath)->std::shared_ptr<Model> {
-        std::vector<tinyobj::shape_t> shapes;
-        std::vector<tinyobj::material_t> materials;
-        tinyobj::attrib_t attributes;
+        const auto cached = binary::MeshFile::path_of(Model::CACHE_DIRECTORY, filepath);
 
-        // TODO: reserve the exact amount of space inside vectors.
-        auto model = std::make_shared<Model>();
-        std::string err;
-
-        bool ret = tinyobj::LoadObj(&attributes, &shapes, &materials, &err, filepath.c_str());
+        auto mesh = binary::MeshFile::open(cached, filepath);
+        if (mesh) {
+            spdlog::trace("Resource Loader : mapped cooked model: {}", cached.string());
+        } else {
+            mesh = cook(filepath, cached);
+        }
+        if (!mesh) { return nullptr; }
+
+        const auto storage = std::make_shared<const binary::MeshFile>(std::move(*mesh));
+        return std::make_shared<Model>(Model{
+            storage->getPositions(),
+            storage->getNormals(),
+            storage->getTexcoords(),
+            storage->getIndices(),
+            storage->getMin(),
+            storage->getMax(),
+            filepath,
+            storage});
+    }
 
-        if (!err.empty()) spdlog::error("{}", err);
+    static auto cook(const std::string &filepath, const std::filesystem::path &cached)
+        ->std::optional<binary::MeshFile> {
+        spdlog::trace("Resource Loader : cooking model: {}", filepath);
 
-        if (!ret) {
+        const auto obj = ObjMesh::load(filepath);
+        if (!obj) {
             spdlog::error("failed to load model.");
-            return nullptr;
+            return {};
         }
 
-        // possible using glm/gtx/hash header.
-        std::unordered_map<glm::vec3, uint32_t> uniqueVertices;
-
-        // TODO: move this code into the model loader.
-        for (const auto &shape : shapes) {
-            for (const auto &index : shape.mesh.indices) {
-                const glm::vec3 position{
-                    attributes.vertices[3 * size_t(index.vertex_index) + 0],
-                    attributes.vertices[3 * size_t(index.vertex_index) + 1],
-                    attributes.vertices[3 * size_t(index.vertex_index) + 2]};
-
-                glm::vec3 normal{glm::vec3(0.0)};
-                glm::vec2 texcoord{glm::vec2(0.0)};
-
-                if (index.normal_index >= 0)
-                    normal = {
-                        attributes.normals[3 * size_t(index.normal_index) + 0],
-                        attributes.normals[3 * size_t(index.normal_index) + 1],
-                        attributes.normals[3 * size_t(index.normal_index) + 2]};
-
-                if (index.texcoord_index >= 0)
-                    texcoord = {
-                        attributes.texcoords[2 * size_t(index.texcoord_index) + 0],
-                        attributes.texcoords[2 * size_t(index.texcoord_index) + 1],
-                    };
-
-                if (!uniqueVertices.contains(position)) {
-                    uniqueVertices[position] = static_cast<uint32_t>(model->vertices.size() / 3);
-
-                    model->vertices.push_back(position.x);
-                    model->vertices.push_back(position.y);
-                    model->vertices.push_back(position.z);
-
-                    model->normals.push_back(normal.x);
-                    model->normals.push_back(normal.y);
-                    model->normals.push_back(normal.z);
-
-                    model->texcoords.push_back(texcoord.x);
-                    model->texcoords.push_back(texcoord.y);
-                }
-
-                model->indices.push_back(uniqueVertices[position]);
-            }
+        auto mesh = MeshOptimizer::weld(*obj);
+        const auto welded_acmr = MeshOptimizer::acmr(mesh.indices, mesh.vertex_count());
+        MeshOptimizer::optimize(mesh);
+        spdlog::trace(
+            "Resource Loader : {} vertices from {} corners, acmr {:.3f} -> {:.3f}",
+            mesh.vertex_count(),
+            obj->corners.size(),
+            welded_acmr,
+            MeshOptimizer::acmr(mesh.indices, mesh.vertex_count()));
+
+        const auto source = binary::MeshFile::describe(filepath).value_or(binary::MeshFile::Source{});
+        auto bytes = binary::MeshFile::cook({mesh.positions, mesh.normals, mesh.texcoords, mesh.indices}, source);
+
+        // note : mapped back so the pages are shared with the file cache rather than held by the process
+        if (binary::MeshFile::save(cached, bytes)) {
+            if (auto mapped = binary::MeshFile::open(cached, filepath); mapped) { return mapped; }
         }
-
-        return model;
+        return binary::MeshFile::from_memory(std::move(bytes));
     })
 
 // creates a texture loader.
@@ -297,7 +297,8 @@ static auto stride_editor(
         std::array<float, S> stride{};
         std::copy(it, it + static_cast<long>(vbo.stride_size), stride.begin());
         if (widget(index, stride)) {
-            auto temp = vbo.vertices;
+            // note : the vertices may be mapped from a file, they are only copied once edited
+            std::vector<float> temp{vbo.vertices.begin(), vbo.vertices.end()};
             for (std::size_t i = 0; i != vbo.stride_size; i++) {
                 temp[index * vbo.stride_size + i] = stride[i];
             }
@@ -320,7 +321,7 @@ static auto stride_editor_ebo(
         std::array<std::uint32_t, S> stride{};
         std::copy(it, it + 3, stride.begin());
         if (widget(index, stride)) {
-            auto temp = ebo.indices;
+            std::vector<std::uint32_t> temp{ebo.indices.begin(), ebo.indices.end()};
             for (std::size_t i = 0; i != 3; i++) { temp[index * 3 + i] = stride[i]; }
             kawe::Render::EBO::emplace(world, e, temp);
             return;
@@ -3,6 +3,9 @@
 #include <ImGuiFileDialog.h>
 
 #include "EventProvider.hpp"
+#include "Replay.hpp"
+#include "binary/EventLog.hpp"
+#include "json/JsonEventReader.hpp"
 #include "json/SerializeEvent.hpp"
 #include "helpers/TimeToString.hpp"
 
@@ -10,11 +13,9 @@ namespace kawe {
 
 struct EventMonitor {
     EventProvider &provider;
+    Replay &replay;
 
-    EventMonitor(EventProvider &p, entt::registry &world) : provider{p}
-    {
-        world.ctx<entt::dispatcher *>()->sink<event::TimeElapsed>().connect<&EventMonitor::on_time_elapsed>(*this);
-    }
+    EventMonitor(EventProvider &p, Replay &r) : provider{p}, replay{r} {}
 
     auto draw() -> void
     {
@@ -22,76 +23,112 @@ struct EventMonitor {
 
         ImGuiHelper::Text("Provider State: {}", magic_enum::enum_name(provider.getState()).data());
 
-        ImGui::PlotLines(
-            "",
-            times_plot.data(),
-            static_cast<int>(times_plot.size()),
-            0,
-            "Average nanoseconds",
-            0.0f,
-            10'000'000.0f,
-            ImVec2(0, 80.0f));
-
         auto v = static_cast<float>(provider.getTimeScaler());
         if (ImGui::SliderFloat("World Time Speed", &v, 0.0f, 100.0f, "%.3f", ImGuiSliderFlags_Logarithmic)) {
             provider.setTimeScaler(static_cast<double>(v));
         }
-        {
-            const auto last_time_elapsed = provider.getLastEventWhere(
-                [](auto &i) { return std::holds_alternative<event::TimeElapsed>(i); });
-
-            if (last_time_elapsed.has_value()) {
-                nlohmann::json as_json;
-                to_json(as_json, *last_time_elapsed.value());
-                ImGuiHelper::Text("Last Time Elapsed :\n{}", as_json.dump(4).data());
+        if (const auto last_time_elapsed = provider.getLastEvent<event::TimeElapsed>(); last_time_elapsed != nullptr) {
+            // note : only serialized when a new one has been processed
+            if (const auto count = provider.getEventCount<event::TimeElapsed>(); count != last_time_elapsed_count) {
+                last_time_elapsed_count = count;
+                last_time_elapsed_text = dump(*last_time_elapsed);
             }
+            ImGuiHelper::Text("Last Time Elapsed :\n{}", last_time_elapsed_text);
         }
         ImGui::Separator();
-        ImGuiHelper::Text("Number of Event pending: {}", provider.getEventsPending().size());
+        ImGuiHelper::Text("Number of Event pending: {}", provider.getEventsPendingCount());
+        ImGuiHelper::Text(
+            "Input latency: {} us (dropped: {}, coalesced: {})",
+            std::chrono::duration_cast<std::chrono::microseconds>(provider.getLastInputLatency()).count(),
+            provider.getEventsDropped(),
+            provider.getEventsCoalesced());
         ImGuiFileDialog::Instance()->SetExtentionInfos(".json", ImVec4(1.0f, 1.0f, 0.0f, 0.9f));
+        ImGuiFileDialog::Instance()->SetExtentionInfos(
+            binary::EventLogFormat::EXTENSION, ImVec4(0.0f, 1.0f, 1.0f, 0.9f));
 
         if (ImGui::Button("import"))
-            ImGuiFileDialog::Instance()->OpenDialog("kawe::inspect::event::pending", "Choose File", ".json", ".");
+            ImGuiFileDialog::Instance()->OpenDialog(
+                "kawe::inspect::event::pending",
+                "Choose File",
+                fmt::format("{},.json", binary::EventLogFormat::EXTENSION).data(),
+                ".");
+        ImGui::SameLine();
+        if (auto fast_forward = provider.getPlaybackMode() == EventProvider::PlaybackMode::FAST_FORWARD;
+            ImGui::Checkbox("fast forward", &fast_forward)) {
+            provider.setPlaybackMode(
+                fast_forward ? EventProvider::PlaybackMode::FAST_FORWARD : EventProvider::PlaybackMode::REAL_TIME);
+        }
 
         if (ImGuiFileDialog::Instance()->Display("kawe::inspect::event::pending")) {
             if (ImGuiFileDialog::Instance()->IsOk()) {
-                const auto path = ImGuiFileDialog::Instance()->GetFilePathName();
-
-                std::ifstream ifs(path);
-                if (ifs.is_open()) {
-                    const auto j = nlohmann::json::parse(ifs);
-
-                    provider.setPendingEvents(j.get<std::vector<event::Event>>());
+                const auto path = std::filesystem::path{ImGuiFileDialog::Instance()->GetFilePathName()};
+
+                if (path.extension() == binary::EventLogFormat::EXTENSION) {
+                    // note : the log is memory mapped and decoded while it is replayed
+                    if (auto log = std::make_unique<binary::EventLogReader>(path); log->is_open()) {
+                        provider.setPendingEvents(std::move(log));
+                        provider.setState(EventProvider::State::PLAYBACK);
+                        replay.reset();
+                    } else {
+                        spdlog::warn("EventMonitor failed to open file: {}", path.string());
+                    }
+                } else if (auto log = std::make_unique<JsonEventReader>(path); log->is_open()) {
+                    // note : the file is parsed on a background thread, the playback starts with the first chunk
+                    provider.setPendingEvents(std::move(log));
                     provider.setState(EventProvider::State::PLAYBACK);
+                    replay.reset();
                 } else {
-                    spdlog::warn("EventMonitor failed to open file: {}", path);
+                    spdlog::warn("EventMonitor failed to open file: {}", path.string());
                 }
             }
 
             ImGuiFileDialog::Instance()->Close();
         }
 
+        if (const auto size = provider.getPlaybackSize(); size != 0) {
+            // note : the seek is only requested once the slider is released, every seek restores a keyframe
+            if (!scrubbing) { scrub_position = static_cast<int>(provider.getPlaybackPosition()); }
+            ImGui::SliderInt("replay", &scrub_position, 0, static_cast<int>(size));
+            scrubbing = ImGui::IsItemActive();
+            if (ImGui::IsItemDeactivatedAfterEdit()) { replay.requestSeek(static_cast<std::size_t>(scrub_position)); }
+            ImGuiHelper::Text(
+                "Keyframes: {}, seek up to the event {}{}",
+                replay.getKeyframes().size(),
+                std::min(replay.getSeekLimit(), size),
+                replay.isSeeking() ? " (seeking...)" : "");
+        }
+
         ImGui::Separator();
-        ImGuiHelper::Text("Number of Event processed: {}", provider.getEventsProcessed().size());
+        ImGuiHelper::Text("Number of Event processed: {}", provider.getEventsProcessedCount());
+        ImGuiHelper::Text("Journal: {}", provider.getJournal().getPath().string());
         if (ImGui::Button("clear")) { provider.clear(); }
         if (ImGui::Button("export") && provider.getState() == EventProvider::State::RECORD) {
-            // todo : should be in a async call ?
-            nlohmann::json serialized(provider.getEventsProcessed());
-            std::filesystem::create_directories("logs");
-            std::ofstream f{fmt::format("logs/recorded_events_{}.json", time_to_string())};
-            f << serialized;
+            provider.getJournal().exportTo(
+                fmt::format("logs/exported_events_{}{}", time_to_string(), binary::EventLogFormat::EXTENSION));
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("export as json") && provider.getState() == EventProvider::State::RECORD) {
+            provider.getJournal().exportTo(fmt::format("logs/exported_events_{}.json", time_to_string()));
         }
         ImGui::SameLine();
         ImGui::Checkbox("export on close", &export_on_close);
+        if (const auto &journal = provider.getJournal(); journal.isExporting()) {
+            ImGui::ProgressBar(journal.getExportProgress(), ImVec2(-1.0f, 0.0f), "exporting...");
+        }
         ImGui::Separator();
-        {
-            const auto last_not_time_elapsed = provider.getLastEventWhere(
-                [](auto &i) { return !std::holds_alternative<event::TimeElapsed>(i); });
-
-            if (last_not_time_elapsed.has_value()) {
-                nlohmann::json as_json;
-                to_json(as_json, *last_not_time_elapsed.value());
-                ImGuiHelper::Text("Last event :\n{}", as_json.dump(4).data());
+        if (const auto count = provider.getInputEventCount(); count != 0) {
+            if (count != last_input_count) {
+                last_input_count = count;
+                last_input_text = dump(provider.getLastInputEvent());
+            }
+            ImGuiHelper::Text("Last event :\n{}", last_input_text);
+        }
+
+        if (ImGui::CollapsingHeader("Events by type")) {
+            const auto &counts = provider.getEventCountByType();
+            for (auto type = 1ul; type != counts.size(); type++) {
+                if (counts[type] == 0) { continue; }
+                ImGuiHelper::Text("{}: {}", event::type_name(provider.getLastEventOfType(type)), counts[type]);
             }
         }
 
@@ -101,16 +138,20 @@ struct EventMonitor {
     bool export_on_close = true;
 
 private:
-    std::list<event::TimeElapsed> times;
-    std::vector<float> times_plot;
+    int scrub_position{0};
+    bool scrubbing{false};
 
-    auto on_time_elapsed(const event::TimeElapsed &e) -> void
-    {
-        times.push_back(e);
-        if (times.size() > 100) { times.pop_front(); }
+    std::size_t last_time_elapsed_count{0};
+    std::string last_time_elapsed_text;
+    std::size_t last_input_count{0};
+    std::string last_input_text;
 
-        times_plot.clear();
-        for (const auto &i : times) { times_plot.push_back(static_cast<float>(i.elapsed.count())); }
+    template<typename T>
+    static auto dump(const T &event) -> std::string
+    {
+        nlohmann::json as_json;
+        to_json(as_json, event);
+        return as_json.dump(4);
     }
 };
 
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <magic_enum.hpp>
+
+#include "graphics/deps.hpp"
+#include "graphics/GLLayer.hpp"
+#include "FrameStats.hpp"
+#include "graphics/GpuTimers.hpp"
+#include "graphics/GLState.hpp"
+#include "graphics/GpuBufferCache.hpp"
+#include "graphics/GLUploader.hpp"
+#include "graphics/TextureCache.hpp"
+#include "helpers/TimeToString.hpp"
+
+namespace kawe {
+
+struct FrameStatsMonitor {
+    FrameStats &stats;
+    GpuTimers &gpu_timers;
+    GLState &gl_state;
+    GpuBufferCache &buffers;
+    TextureCache &textures;
+    GLUploader &uploader;
+
+    auto draw() -> void
+    {
+        if (!ImGui::Begin("KAWE: Frame Stats")) return ImGui::End();
+
+        const auto budget_ms = to_ms(static_cast<std::uint64_t>(stats.getBudget().count()));
+        const auto history = stats.getHistory();
+        ImGui::PlotLines(
+            "",
+            history.data(),
+            static_cast<int>(history.size()),
+            static_cast<int>(stats.getHistoryOffset()),
+            fmt::format("frame time (ms), budget {:.2f}", budget_ms).data(),
+            0.0f,
+            static_cast<float>(budget_ms * 2.0),
+            ImVec2(0, 80.0f));
+
+        auto budget = static_cast<float>(budget_ms);
+        if (ImGui::SliderFloat("Budget (ms)", &budget, 1.0f, 100.0f, "%.2f", ImGuiSliderFlags_Logarithmic)) {
+            stats.setBudget(std::chrono::nanoseconds{static_cast<std::int64_t>(budget * 1'000'000.0f)});
+        }
+
+        const auto &frames = stats.getFrameHistogram();
+        const auto hitches = stats.getHitchCount();
+        ImGuiHelper::Text(
+            "Frames: {}, hitches: {} ({:.2f}%)",
+            frames.count(),
+            hitches,
+            frames.count() == 0 ? 0.0 : 100.0 * static_cast<double>(hitches) / static_cast<double>(frames.count()));
+
+        // note : the gpu times are read back a few frames late
+        ImGuiHelper::Text(
+            "Last frame: cpu {:.3f} ms", to_ms(static_cast<std::uint64_t>(stats.getLastFrameTime().count())));
+        for (const auto pass : {GpuTimers::Pass::SCENE, GpuTimers::Pass::PICKING, GpuTimers::Pass::IMGUI}) {
+            if (const auto time = gpu_timers.getLast(pass); time.has_value()) {
+                ImGui::SameLine();
+                ImGuiHelper::Text(
+                    "| {} {:.3f} ms",
+                    GpuTimers::SECTION_NAMES[static_cast<std::size_t>(pass)],
+                    to_ms(static_cast<std::uint64_t>(time->count())));
+            }
+        }
+        if (const auto late = gpu_timers.getLateCount(); late != 0) {
+            ImGuiHelper::Text("Gpu results dropped: {}", late);
+        }
+
+        auto &gl = GLLayer::get();
+        const auto &counters = gl.getLastFrame();
+        ImGuiHelper::Text(
+            "GL calls: {}, draws: {}, state changes: {}, uploads: {} ({} bytes), errors: {} (debug output: {})",
+            counters.calls,
+            counters.draw_calls,
+            counters.state_changes,
+            counters.uploads,
+            counters.upload_bytes,
+            counters.errors,
+            counters.callback_errors);
+        ImGuiHelper::Text("GL state changes skipped: {}", gl_state.getSkippedCount());
+        ImGuiHelper::Text(
+            "GL buffers: {} ({} bytes), shared uploads: {}",
+            buffers.getBufferCount(),
+            buffers.getBytes(),
+            buffers.getSharedCount());
+        if (const auto pending = buffers.getPendingCount(); pending != 0) {
+            ImGuiHelper::Text("GL buffers uploading: {}", pending);
+        }
+        ImGuiHelper::Text(
+            "GL textures: {} in {} arrays ({} bytes), shared uploads: {}",
+            textures.getTextureCount(),
+            textures.getPoolCount(),
+            textures.getBytes(),
+            textures.getSharedCount());
+        ImGuiHelper::Text(
+            "GL textures resident: {} / {} bytes, evicted: {}",
+            textures.getResidentBytes(),
+            textures.getBudget(),
+            textures.getEvictedCount());
+        if (const auto pending = textures.getPendingCount(); pending != 0) {
+            ImGuiHelper::Text("GL textures loading: {}", pending);
+        }
+        if (ImGui::BeginCombo("GL error check", magic_enum::enum_name(gl.getErrorCheck()).data())) {
+            for (const auto mode : magic_enum::enum_values<GLLayer::ErrorCheck>()) {
+                if (ImGui::Selectable(magic_enum::enum_name(mode).data(), mode == gl.getErrorCheck())) {
+                    gl.setErrorCheck(mode);
+                    uploader.applyErrorCheck();
+                }
+            }
+            ImGui::EndCombo();
+        }
+
+        ImGui::Columns(5, "kawe::frame_stats");
+        for (const auto &header : {"(ms)", "p50", "p90", "p99", "max"}) {
+            ImGui::TextUnformatted(header);
+            ImGui::NextColumn();
+        }
+        ImGui::Separator();
+        row("frame", frames);
+        for (const auto &section : stats.getSections()) { row(section.name, section.histogram); }
+        ImGui::Columns(1);
+        ImGui::Separator();
+
+        if (ImGui::Button("export csv")) {
+            stats.exportTo(fmt::format("logs/frame_stats_{}.csv", time_to_string()));
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("export json")) {
+            stats.exportTo(fmt::format("logs/frame_stats_{}.json", time_to_string()));
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("reset")) { stats.reset(); }
+
+        ImGui::End();
+    }
+
+private:
+    static auto to_ms(std::uint64_t nanoseconds) -> double { return static_cast<double>(nanoseconds) / 1'000'000.0; }
+
+    static auto row(std::string_view name, const FrameStats::TimeHistogram &histogram) -> void
+    {
+        ImGuiHelper::Text("{}", name);
+        ImGui::NextColumn();
+        for (const auto q : {0.5, 0.9, 0.99}) {
+            ImGuiHelper::Text("{:.3f}", to_ms(histogram.percentile(q)));
+            ImGui::NextColumn();
+        }
+        ImGuiHelper::Text("{:.3f}", to_ms(histogram.max()));
+        ImGui::NextColumn();
+    }
+};
+
+} // namespace kawe
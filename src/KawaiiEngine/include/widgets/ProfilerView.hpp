@@ -0,0 +1,110 @@
+#pragma once
+
+#include "graphics/deps.hpp"
+#include "Profiler.hpp"
+#include "helpers/TimeToString.hpp"
+
+namespace kawe {
+
+/// Flame view of the zones of one recorded frame, one lane per thread.
+struct ProfilerView {
+    auto draw() -> void
+    {
+        if (!ImGui::Begin("KAWE: Profiler")) return ImGui::End();
+
+        auto &profiler = Profiler::get();
+        if constexpr (!Profiler::isEnabled()) {
+            ImGui::TextUnformatted("The profiler has been compiled out, build with ENABLE_PROFILER");
+            return ImGui::End();
+        }
+
+        if (auto paused = profiler.isPaused(); ImGui::Checkbox("pause", &paused)) { profiler.setPaused(paused); }
+        ImGui::SameLine();
+        if (ImGui::Button("export chrome trace")) {
+            profiler.exportChromeTrace(fmt::format("logs/trace_{}.json", time_to_string()));
+        }
+        ImGui::SameLine();
+        ImGuiHelper::Text("dropped zones: {}", profiler.getDroppedZones());
+
+        const auto frames = profiler.getFrames();
+        if (frames.empty()) { return ImGui::End(); }
+
+        // note : follow the last frame unless paused
+        auto selected = static_cast<int>(frames.size()) - 1;
+        if (profiler.isPaused()) {
+            selected_frame = std::clamp(selected_frame, 0, selected);
+            ImGui::SliderInt("frame", &selected_frame, 0, selected);
+            selected = selected_frame;
+        } else {
+            selected_frame = selected;
+        }
+
+        const auto &frame = *frames[static_cast<std::size_t>(selected)];
+        const auto frame_ns = profiler.toNanoseconds(frame.end - frame.begin);
+        ImGuiHelper::Text("frame: {:.3f} ms, {} zones", frame_ns / 1'000'000.0, frame.zones.size());
+
+        for (const auto &thread : profiler.getThreads()) { draw_lane(profiler, frame, thread); }
+
+        ImGui::End();
+    }
+
+private:
+    static constexpr auto LANE_ROW_HEIGHT = 18.0f;
+
+    int selected_frame{0};
+
+    static auto draw_lane(const Profiler &profiler, const Profiler::Frame &frame, const Profiler::ThreadInfo &thread)
+        -> void
+    {
+        std::uint32_t max_depth = 0;
+        auto has_zone = false;
+        for (const auto &zone : frame.zones) {
+            if (zone.thread != thread.id) { continue; }
+            has_zone = true;
+            max_depth = std::max(max_depth, zone.depth);
+        }
+        if (!has_zone) { return; }
+
+        ImGui::TextUnformatted(thread.name.data());
+
+        const auto origin = ImGui::GetCursorScreenPos();
+        const auto width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+        const auto height = static_cast<float>(max_depth + 1) * LANE_ROW_HEIGHT;
+        ImGui::InvisibleButton(fmt::format("lane_{}", thread.id).data(), ImVec2(width, height));
+
+        auto draw_list = ImGui::GetWindowDrawList();
+        const auto frame_length = static_cast<double>(std::max<std::uint64_t>(frame.end - frame.begin, 1));
+        const auto to_x = [&](std::uint64_t ticks) {
+            const auto clamped = std::clamp(ticks, frame.begin, frame.end);
+            return origin.x + static_cast<float>(static_cast<double>(clamped - frame.begin) / frame_length) * width;
+        };
+
+        const auto mouse = ImGui::GetIO().MousePos;
+        for (const auto &zone : frame.zones) {
+            if (zone.thread != thread.id) { continue; }
+
+            const auto min = ImVec2(to_x(zone.begin), origin.y + static_cast<float>(zone.depth) * LANE_ROW_HEIGHT);
+            const auto max = ImVec2(std::max(to_x(zone.end), min.x + 1.0f), min.y + LANE_ROW_HEIGHT - 1.0f);
+
+            // note : the color only depends on the name, so a zone keeps it from one frame to another
+            const auto hash = std::hash<std::string_view>{}(zone.name);
+            const auto color = IM_COL32(
+                96 + static_cast<int>(hash & 0x7F), 96 + static_cast<int>((hash >> 8) & 0x7F), 160, 255);
+            draw_list->AddRectFilled(min, max, color);
+
+            if (max.x - min.x > 30.0f) {
+                draw_list->PushClipRect(min, max, true);
+                draw_list->AddText(ImVec2(min.x + 2.0f, min.y + 1.0f), IM_COL32_BLACK, zone.name);
+                draw_list->PopClipRect();
+            }
+
+            if (ImGui::IsItemHovered() && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y
+                && mouse.y < max.y) {
+                ImGui::SetTooltip(
+                    "%s: %.3f ms", zone.name, profiler.toNanoseconds(zone.end - zone.begin) / 1'000'000.0);
+            }
+        }
+    }
+};
+
+} // namespace kawe
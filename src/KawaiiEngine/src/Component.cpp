@@ -1,3 +1,3 @@
 #include "component.hpp"
 
-const kawe::Texture2D kawe::Texture2D::empty{"", 0, nullptr};
+const kawe::Texture2D kawe::Texture2D::empty{"", kawe::TextureCache::NONE};
@@ -39,23 +39,10 @@ kawe::Engine::Engine() : entity_hierarchy{component_inspector.selected}
 
     spdlog::get("console")->debug("[Engine] OpenGL version supported by this platform ({})", glGetString(GL_VERSION));
 
-    // todo : only in debug mode
-    glEnable(GL_DEBUG_OUTPUT);
-    glDebugMessageCallback(
-        []([[maybe_unused]] GLenum source,
-           GLenum type,
-           [[maybe_unused]] GLuint id,
-           [[maybe_unused]] GLenum severity,
-           [[maybe_unused]] GLsizei length,
-           const GLchar *message,
-           const void *) {
-            if (type == GL_DEBUG_TYPE_ERROR) {
-                spdlog::get("console")->error("[Engine] GL CALLBACK: message = {}", message);
-            } else {
-                spdlog::get("console")->warn("[Engine] GL CALLBACK: message = {}", message);
-            }
-        },
-        nullptr);
+    // note : the debug output and the error checks depend on the mode selected in the layer
+    GLLayer::get().init();
+
+    uploader.start(window->get());
 
     {
         IMGUI_CHECKVERSION();
@@ -74,11 +61,22 @@ kawe::Engine::Engine() : entity_hierarchy{component_inspector.selected}
 
     world.set<entt::dispatcher *>(&dispatcher);
     world.set<ResourceLoader *>(&loader);
+    world.set<TimerWheel *>(&timers);
+    frame_stats = std::make_unique<FrameStats>();
+    world.set<FrameStats *>(frame_stats.get());
+    gpu_timers = std::make_unique<GpuTimers>(*frame_stats);
+    world.set<GpuTimers *>(gpu_timers.get());
+    world.set<GLState *>(&gl_state);
+    world.set<GpuBufferCache *>(&buffers);
+    world.set<TextureCache *>(&textures);
     ctx = std::make_unique<Context>(world);
     world.set<Context *>(ctx.get());
 
     events = std::make_unique<EventProvider>(*window);
-    event_monitor = std::make_unique<EventMonitor>(*events, world);
+    replay = std::make_unique<Replay>(world, *events, *ctx, timers);
+    event_monitor = std::make_unique<EventMonitor>(*events, *replay);
+    frame_stats_monitor =
+        std::make_unique<FrameStatsMonitor>(*frame_stats, *gpu_timers, gl_state, buffers, textures, uploader);
     recorder = std::make_unique<Recorder>(*window);
 
     system = std::make_unique<System>(world, dispatcher, *ctx, *window);
@@ -88,6 +86,10 @@ kawe::Engine::Engine() : entity_hierarchy{component_inspector.selected}
 
 kawe::Engine::~Engine()
 {
+    // note : the queries must be deleted while the context is alive
+    gpu_timers.reset();
+    uploader.stop();
+
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
 
@@ -99,9 +101,9 @@ kawe::Engine::~Engine()
 
 auto kawe::Engine::start(const std::function<void(entt::registry &)> on_create) -> void
 {
-    CALL_OPEN_GL(::glEnable(GL_DEPTH_TEST));
-    CALL_OPEN_GL(::glEnable(GL_BLEND));
-    CALL_OPEN_GL(::glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+    gl_state.setCapability(GL_DEPTH_TEST, true);
+    gl_state.setCapability(GL_BLEND, true);
+    gl_state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     const auto camera_one = world.create();
     world.emplace<CameraData>(camera_one);
@@ -109,102 +111,150 @@ auto kawe::Engine::start(const std::function<void(entt::registry &)> on_create)
 
     on_create(world);
 
+    Profiler::get().setThreadName("main");
+
     while (ctx->is_running) {
-        const auto event = events->getNextEvent();
-
-        if (events->getState() == EventProvider::State::PLAYBACK) {
-            std::visit(
-                overloaded{
-                    [&](const event::TimeElapsed &e) { std::this_thread::sleep_for(e.elapsed); },
-                    [&](const event::Moved<event::Mouse> &e) {
-                        window->setCursorPosition({e.x, e.y});
-                    },
-                    [&](const event::Moved<event::Window> &e) {
-                        window->setPosition({e.x, e.y});
-                    },
-                    [&](const event::ResizeWindow &e) {
-                        window->setSize({e.width, e.height});
-                    },
-                    [&](const event::MaximazeWindow &e) { window->maximaze(e.maximazed); },
-                    [&](const event::MinimazeWindow &e) { window->minimaze(e.minimazed); },
-                    [&](const event::FocusWindow &e) { window->focus(e.focused); },
-                    [](const auto &) {}},
-                event);
+        {
+            KAWE_PROFILE_ZONE("poll events");
+            events->pollEvents();
         }
 
+        // drain every pending input, the frame is simulated and rendered by the TimeElapsed closing the queue
+        for (auto end_of_frame = false; !end_of_frame && ctx->is_running;) {
+            const auto event = events->getNextEvent();
+            end_of_frame = std::holds_alternative<event::TimeElapsed>(event);
+            process(event);
+        }
+    }
+
+    // the journal has been written during the whole session, just finish it
+    auto &journal = events->getJournal();
+    journal.close();
+    if (!event_monitor->export_on_close) { std::filesystem::remove(journal.getPath()); }
+
+    world.clear();
+}
+
+auto kawe::Engine::process(const event::Event &event) -> void
+{
+    const auto fast_forward = events->isFastForwarding();
+
+    if (events->getState() == EventProvider::State::PLAYBACK && !fast_forward) {
         std::visit(
             overloaded{
-                [&](const event::Connected<event::Window> &) {
-                    events->setCurrentTimepoint(std::chrono::steady_clock::now());
-                },
-                [&](const event::Disconnected<event::Window> &) { ctx->is_running = false; },
-                [&](const event::Moved<event::Mouse> &mouse) {
-                    ctx->mouse_pos = {mouse.x, mouse.y};
-                    dispatcher.trigger<event::Moved<event::Mouse>>(mouse);
-                },
-                [&](const event::Pressed<event::MouseButton> &e) {
-                    window->sendEventToImGui(e);
-                    ctx->state_mouse_button[e.source.button] = true;
-                    ctx->mouse_pos_when_pressed = ctx->mouse_pos;
-                    dispatcher.trigger<event::Pressed<event::MouseButton>>(e);
-                },
-                [&](const event::Released<event::MouseButton> &e) {
-                    window->sendEventToImGui(e);
-                    ctx->state_mouse_button[e.source.button] = false;
-                    dispatcher.trigger<event::Released<event::MouseButton>>(e);
-                },
-                [&](const event::Pressed<event::Key> &e) {
-                    window->sendEventToImGui(e);
-                    ctx->keyboard_state[e.source.keycode] = true;
-                    // todo : should be a signal instead
-                    if (e.source.keycode == event::Key::Code::KEY_F10) {
-                        std::filesystem::create_directories("screenshot");
-                        window->screenshot(fmt::format("screenshot/screenshot_{}.png", time_to_string()));
-                    }
-                    dispatcher.trigger<event::Pressed<event::Key>>(e);
-                },
-                [&](const event::Released<event::Key> &e) {
-                    window->sendEventToImGui(e);
-                    ctx->keyboard_state[e.source.keycode] = false;
-                    dispatcher.trigger<event::Released<event::Key>>(e);
-                },
-                [&](const event::Character &e) {
-                    window->sendEventToImGui(e);
-                    dispatcher.trigger<event::Character>(e);
-                },
-                [&](const event::MouseScroll &e) {
-                    window->sendEventToImGui(e);
-                    dispatcher.trigger<event::MouseScroll>(e);
-                },
-                [&](const event::TimeElapsed &e) {
-                    // todo : trigger a time elapsed only if the simulation is running
-                    ImGui_ImplOpenGL3_NewFrame();
-                    ImGui_ImplGlfw_NewFrame();
-                    ImGui::NewFrame();
-
-                    dispatcher.trigger<action::Render<Render::Layout::UI>>({});
-
-                    ImGui::Render();
-
-                    dispatcher.trigger<action::Render<Render::Layout::SCENE>>({});
-
-                    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-                    glfwSwapBuffers(window->get());
-
-                    dispatcher.trigger<event::TimeElapsed>(e);
-                },
+                [&](const event::TimeElapsed &e) { std::this_thread::sleep_for(e.elapsed); },
+                [&](const event::Moved<event::Mouse> &e) { window->setCursorPosition({e.x, e.y}); },
+                [&](const event::Moved<event::Window> &e) { window->setPosition({e.x, e.y}); },
+                [&](const event::ResizeWindow &e) { window->setSize({e.width, e.height}); },
+                [&](const event::MaximazeWindow &e) { window->maximaze(e.maximazed); },
+                [&](const event::MinimazeWindow &e) { window->minimaze(e.minimazed); },
+                [&](const event::FocusWindow &e) { window->focus(e.focused); },
                 [](const auto &) {}},
             event);
     }
 
-    if (event_monitor->export_on_close) {
-        nlohmann::json serialized(events->getEventsProcessed());
-        std::filesystem::create_directories("logs");
-        std::ofstream f{fmt::format("logs/recorded_events_{}.json", time_to_string())};
-        f << serialized;
-    }
+    std::visit(
+        overloaded{
+            [&](const event::Connected<event::Window> &) {
+                events->setCurrentTimepoint(std::chrono::steady_clock::now());
+            },
+            [&](const event::Disconnected<event::Window> &) { ctx->is_running = false; },
+            [&](const event::Moved<event::Mouse> &mouse) {
+                ctx->mouse_pos = {mouse.x, mouse.y};
+                dispatcher.trigger<event::Moved<event::Mouse>>(mouse);
+            },
+            [&](const event::Pressed<event::MouseButton> &e) {
+                window->sendEventToImGui(e);
+                ctx->state_mouse_button[e.source.button] = true;
+                ctx->mouse_pos_when_pressed = ctx->mouse_pos;
+                dispatcher.trigger<event::Pressed<event::MouseButton>>(e);
+            },
+            [&](const event::Released<event::MouseButton> &e) {
+                window->sendEventToImGui(e);
+                ctx->state_mouse_button[e.source.button] = false;
+                dispatcher.trigger<event::Released<event::MouseButton>>(e);
+            },
+            [&](const event::Pressed<event::Key> &e) {
+                window->sendEventToImGui(e);
+                ctx->keyboard_state[e.source.keycode] = true;
+                // todo : should be a signal instead
+                if (e.source.keycode == event::Key::Code::KEY_F10) {
+                    std::filesystem::create_directories("screenshot");
+                    window->screenshot(fmt::format("screenshot/screenshot_{}.png", time_to_string()));
+                }
+                dispatcher.trigger<event::Pressed<event::Key>>(e);
+            },
+            [&](const event::Released<event::Key> &e) {
+                window->sendEventToImGui(e);
+                ctx->keyboard_state[e.source.keycode] = false;
+                dispatcher.trigger<event::Released<event::Key>>(e);
+            },
+            [&](const event::Character &e) {
+                window->sendEventToImGui(e);
+                dispatcher.trigger<event::Character>(e);
+            },
+            [&](const event::MouseScroll &e) {
+                window->sendEventToImGui(e);
+                dispatcher.trigger<event::MouseScroll>(e);
+            },
+            [&](const event::TimeElapsed &e) {
+                const auto now = std::chrono::steady_clock::now();
+                if (!fast_forward || now - last_present >= FAST_FORWARD_PRESENT_INTERVAL) {
+                    last_present = now;
+
+                    KAWE_PROFILE_ZONE("present");
+
+                    {
+                        KAWE_PROFILE_ZONE("ImGui::NewFrame");
+                        // todo : trigger a time elapsed only if the simulation is running
+                        ImGui_ImplOpenGL3_NewFrame();
+                        ImGui_ImplGlfw_NewFrame();
+                        ImGui::NewFrame();
+                    }
+                    {
+                        KAWE_PROFILE_ZONE("Render<UI>");
+                        dispatcher.trigger<action::Render<Render::Layout::UI>>({});
+                        ImGui::Render();
+                    }
+                    {
+                        KAWE_PROFILE_ZONE("uploads");
+                        uploader.update();
+                        textures.update();
+                    }
+                    {
+                        KAWE_PROFILE_ZONE("Render<SCENE>");
+                        dispatcher.trigger<action::Render<Render::Layout::SCENE>>({});
+                    }
+                    {
+                        KAWE_PROFILE_ZONE("ImGui draw");
+                        const auto gpu_measured = gpu_timers->measure(GpuTimers::Pass::IMGUI);
+                        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+                        // note : the backend restores the state it changes, but nothing guarantees the cache is
+                        //        still right afterward, the next frame only re-binds once
+                        gl_state.invalidate();
+                    }
+                    {
+                        KAWE_PROFILE_ZONE("glfwSwapBuffers");
+                        glfwSwapBuffers(window->get());
+                    }
+                    gpu_timers->end_frame();
+                    GLLayer::get().end_frame();
+                }
 
-    world.clear();
+                {
+                    KAWE_PROFILE_ZONE("TimeElapsed");
+                    dispatcher.trigger<event::TimeElapsed>(e);
+                }
+                {
+                    KAWE_PROFILE_ZONE("replay");
+                    replay->on_frame_end();
+                }
+
+                frame_stats->end_frame();
+                Profiler::get().endFrame();
+            },
+            [](const auto &) {}},
+        event);
 }
 
 auto kawe::Engine::on_imgui(const kawe::action::Render<kawe::Render::Layout::UI>) -> void
@@ -238,6 +288,8 @@ auto kawe::Engine::on_imgui(const kawe::action::Render<kawe::Render::Layout::UI>
         entity_hierarchy.draw(world);
         component_inspector.draw<Component>(world);
         event_monitor->draw();
+        frame_stats_monitor->draw();
+        profiler_view.draw();
         recorder->draw();
         console.draw();
     }
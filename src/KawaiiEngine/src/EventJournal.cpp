@@ -0,0 +1,188 @@
+#include "EventJournal.hpp"
+#include "helpers/overloaded.hpp"
+#include "Profiler.hpp"
+
+kawe::EventJournal::EventJournal(std::filesystem::path path) : m_path{std::move(path)}
+{
+    m_chunk.reserve(CHUNK_SIZE);
+    m_jobs.push_back({Job::Kind::REOPEN, {}, m_path});
+    m_writer = std::thread{[this] { run(); }};
+}
+
+kawe::EventJournal::~EventJournal() { close(); }
+
+auto kawe::EventJournal::record(const event::Event &event) -> void
+{
+    if (std::holds_alternative<std::monostate>(event)) { return; }
+
+    if (!m_chunk.empty()) {
+        const auto merged = std::visit(
+            overloaded{
+                [](event::TimeElapsed &prev, const event::TimeElapsed &next) {
+                    prev += next;
+                    return true;
+                },
+                [](const auto &, const auto &) { return false; }},
+            m_chunk.back(),
+            event);
+        if (merged) { return; }
+    }
+
+    // note : the chunk is handed over only when a new entry is needed, so its last event can still be merged
+    if (m_chunk.size() == CHUNK_SIZE) { flush(); }
+
+    m_chunk.push_back(event);
+    m_count++;
+}
+
+auto kawe::EventJournal::flush() -> void
+{
+    if (m_chunk.empty()) { return; }
+
+    auto chunk = std::vector<event::Event>{};
+    chunk.reserve(CHUNK_SIZE);
+    std::swap(chunk, m_chunk);
+    submit({Job::Kind::WRITE, std::move(chunk), {}});
+}
+
+auto kawe::EventJournal::exportTo(std::filesystem::path path) -> void
+{
+    flush();
+    m_exports_pending++;
+    submit({Job::Kind::EXPORT, {}, std::move(path)});
+}
+
+auto kawe::EventJournal::restart(std::filesystem::path path) -> void
+{
+    m_chunk.clear();
+    m_count = 0;
+    m_path = path;
+    submit({Job::Kind::REOPEN, {}, std::move(path)});
+}
+
+auto kawe::EventJournal::close() -> void
+{
+    if (!m_writer.joinable()) { return; }
+
+    flush();
+    {
+        std::lock_guard lock{m_mutex};
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_writer.join();
+}
+
+auto kawe::EventJournal::submit(Job &&job) -> void
+{
+    {
+        std::unique_lock lock{m_mutex};
+        // note : only wait if the writer is far behind, in order to keep the memory bounded
+        m_cv.wait(lock, [this] { return m_jobs.size() < MAX_PENDING_JOBS; });
+        m_jobs.push_back(std::move(job));
+    }
+    m_cv.notify_all();
+}
+
+auto kawe::EventJournal::run() -> void
+{
+    Profiler::get().setThreadName("journal writer");
+
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock lock{m_mutex};
+            m_cv.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+            if (m_jobs.empty()) { break; }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        m_cv.notify_all();
+
+        switch (job.kind) {
+        case Job::Kind::WRITE: {
+            KAWE_PROFILE_ZONE("journal write");
+            write(job.chunk);
+        } break;
+        case Job::Kind::EXPORT: {
+            KAWE_PROFILE_ZONE("journal export");
+            copy(job.path);
+            m_exports_pending--;
+        } break;
+        case Job::Kind::REOPEN:
+            retire();
+            open(job.path);
+            break;
+        }
+    }
+
+    m_file.reset();
+}
+
+auto kawe::EventJournal::retire() -> void
+{
+    m_file.reset();
+    if (m_file_path.empty()) { return; }
+
+    // note : closed first, an open file can not be deleted on every platform
+    if (!m_file_exported) {
+        std::error_code err;
+        std::filesystem::remove(m_file_path, err);
+        if (err) { spdlog::warn("EventJournal: failed to delete {}: {}", m_file_path.string(), err.message()); }
+    }
+    m_file_path.clear();
+    m_file_exported = false;
+}
+
+auto kawe::EventJournal::open(const std::filesystem::path &path) -> void
+{
+    if (path.has_parent_path()) { std::filesystem::create_directories(path.parent_path()); }
+    m_file = std::make_unique<binary::EventLogWriter>(path);
+    if (!m_file->is_open()) {
+        m_file.reset();
+        return;
+    }
+
+    m_file_path = path;
+}
+
+auto kawe::EventJournal::write(const std::vector<event::Event> &chunk) -> void
+{
+    if (!m_file) { return; }
+
+    m_file->write(chunk);
+}
+
+auto kawe::EventJournal::copy(const std::filesystem::path &path) -> void
+{
+    if (!m_file) { return; }
+    m_file->flush();
+
+    m_export_done = 0;
+    m_export_total = m_file->size();
+
+    std::error_code err;
+    if (path.has_parent_path()) { std::filesystem::create_directories(path.parent_path(), err); }
+
+    if (path.extension() == ".json") {
+        const auto on_progress = [this](auto done, auto total) {
+            m_export_done = done;
+            m_export_total = total;
+        };
+        if (!binary::convert_log_to_json(m_file_path, path, on_progress)) {
+            spdlog::error("EventJournal: failed to export to {}", path.string());
+        } else {
+            m_file_exported = true;
+        }
+        return;
+    }
+
+    // note : every block written is complete, so the copy of the journal is a valid log
+    std::filesystem::copy_file(m_file_path, path, std::filesystem::copy_options::overwrite_existing, err);
+    if (err) {
+        spdlog::error("EventJournal: failed to export to {}: {}", path.string(), err.message());
+    } else {
+        m_file_exported = true;
+    }
+    m_export_done = m_export_total.load();
+}
@@ -6,90 +6,116 @@
 #include "graphics/Window.hpp"
 #include "EventProvider.hpp"
 #include "helpers/overloaded.hpp"
+#include "helpers/TimeToString.hpp"
 
 kawe::EventProvider *kawe::EventProvider::s_instance = nullptr;
 
-kawe::EventProvider::EventProvider(const Window &window) : m_window{window}
+kawe::EventProvider::EventProvider(const Window &window) : m_window{window}, m_journal{make_journal_path()}
 {
     s_instance = this;
     setState(State::RECORD);
-    m_buffer_events.emplace_back(event::Connected<event::Window>{});
+    capture(event::Connected<event::Window>{});
 }
 
 auto kawe::EventProvider::getNextEvent() -> event::Event
 {
     const auto event = fetchEvent();
 
-    if (!m_events_processed.empty()) {
-        std::visit(
-            overloaded{
-                [](event::TimeElapsed &prev, const event::TimeElapsed &next) { prev += next; },
-                [&](const auto &, const auto &next) { m_events_processed.push_back(next); }},
-            m_events_processed.back(),
-            event);
-    } else
-        [[unlikely]] { m_events_processed.push_back(event); }
+    m_journal.record(event);
+
+    const auto type = event.index();
+    m_last_event_by_type[type] = event;
+    m_event_count_by_type[type]++;
+    if (!std::holds_alternative<event::TimeElapsed>(event)) {
+        m_last_input_type = type;
+        m_input_count++;
+    }
 
     return event;
 }
 
-auto kawe::EventProvider::getLastEventWhere(const std::function<bool(const event::Event &)> &predicate) const noexcept
-    -> std::optional<const event::Event *>
+auto kawe::EventProvider::fetchEvent() -> event::Event
 {
-    if (const auto found = std::find_if(m_events_processed.rbegin(), m_events_processed.rend(), predicate);
-        found != m_events_processed.rend()) {
-        return &(*found);
-    } else {
-        return {};
+    if (!m_playback_front.has_value() && m_playback) { m_playback_front = m_playback->next(); }
+
+    if (m_playback_front.has_value()) {
+        if (auto time = std::get_if<event::TimeElapsed>(&*m_playback_front); time != nullptr && time->stack >= 2ul) {
+            const auto get_nth = [](auto total, auto part) {
+                return static_cast<std::int64_t>(static_cast<double>(total) * (1.0 / static_cast<double>(part)));
+            };
+
+            const auto elapsed = std::chrono::nanoseconds{get_nth(time->elapsed.count(), time->stack)};
+            const auto world_time = std::chrono::nanoseconds{get_nth(time->world_time.count(), time->stack)};
+
+            time->elapsed -= elapsed;
+            time->world_time -= world_time;
+            time->stack--;
+
+            return event::TimeElapsed{elapsed, world_time, time->stack};
+        }
+
+        auto event = std::move(*m_playback_front);
+        m_playback_front.reset();
+        return event;
+    }
+
+    if (const auto captured = m_captured_events.front(); captured != nullptr) {
+        m_last_input_latency = std::chrono::steady_clock::now() - captured->timestamp;
+        auto event = std::move(captured->event);
+        m_captured_events.pop();
+        coalesce(event);
+        return event;
+    }
+
+    if (m_state == State::PLAYBACK) {
+        setState(State::RECORD);
+        // the replay did not measure the time, don t count its duration in the first recorded frame
+        m_lastTimePoint = std::chrono::steady_clock::now();
+    }
+
+    const auto elapsed = getElapsedTime();
+    return event::TimeElapsed{
+        std::chrono::nanoseconds{static_cast<std::int64_t>(static_cast<double>(elapsed.count()))},
+        std::chrono::nanoseconds{static_cast<std::int64_t>(static_cast<double>(elapsed.count()) * m_time_scaler)},
+        1ul};
+}
+
+auto kawe::EventProvider::coalesce(event::Event &event) -> void
+{
+    // note : only adjacent events are merged, so the order relative to the other inputs is kept
+    const auto merge = overloaded{
+        [](event::Moved<event::Mouse> &into, const event::Moved<event::Mouse> &next) {
+            into = next;
+            return true;
+        },
+        [](event::MouseScroll &into, const event::MouseScroll &next) {
+            into.x += next.x;
+            into.y += next.y;
+            return true;
+        },
+        [](const auto &, const auto &) { return false; }};
+
+    for (auto next = m_captured_events.front(); next != nullptr; next = m_captured_events.front()) {
+        if (!std::visit(merge, event, next->event)) { break; }
+        m_captured_events.pop();
+        m_events_coalesced++;
     }
 }
 
-auto kawe::EventProvider::fetchEvent() -> event::Event
+auto kawe::EventProvider::capture(event::Event &&event) -> void
 {
-    ::glfwPollEvents();
-
-    if (m_buffer_events.empty()) {
-        if (m_state == State::PLAYBACK) { setState(State::RECORD); }
-
-        const auto elapsed = getElapsedTime();
-        return event::TimeElapsed{
-            std::chrono::nanoseconds{static_cast<std::int64_t>(static_cast<double>(elapsed.count()))},
-            std::chrono::nanoseconds{
-                static_cast<std::int64_t>(static_cast<double>(elapsed.count()) * m_time_scaler)},
-            1ul};
-    } else {
-        // note : for some reason, I can't call .erase in the visit
-        bool erase_last_one = true;
-        const auto event = std::visit(
-            overloaded{
-                [&](event::TimeElapsed &time) -> event::Event {
-                    if (time.stack < 2ul) {
-                        return time;
-                    } else {
-                        const auto get_nth = [](auto total, auto part) {
-                            return static_cast<std::int64_t>(
-                                static_cast<double>(total) * (1.0 / static_cast<double>(part)));
-                        };
-
-                        const auto elapsed = std::chrono::nanoseconds{get_nth(time.elapsed.count(), time.stack)};
-                        const auto world_time =
-                            std::chrono::nanoseconds{get_nth(time.world_time.count(), time.stack)};
-
-                        time.elapsed -= elapsed;
-                        time.world_time -= world_time;
-                        time.stack--;
-
-                        erase_last_one = false;
-                        return event::TimeElapsed{elapsed, world_time, time.stack};
-                    }
-                },
-                [&erase_last_one](const auto &other) -> event::Event { return other; }},
-            m_buffer_events.front());
-        if (erase_last_one) { m_buffer_events.erase(m_buffer_events.begin()); }
-        return event;
+    if (!m_captured_events.push(std::chrono::steady_clock::now(), std::move(event))) {
+        if (m_events_dropped.fetch_add(1, std::memory_order_relaxed) == 0) {
+            spdlog::warn("EventProvider: input buffer is full ({} events), dropping events", CAPTURE_CAPACITY);
+        }
     }
 }
 
+auto kawe::EventProvider::make_journal_path() -> std::filesystem::path
+{
+    return fmt::format("logs/recorded_events_{}{}", time_to_string(), binary::EventLogFormat::EXTENSION);
+}
+
 auto kawe::EventProvider::getElapsedTime() noexcept -> std::chrono::nanoseconds
 {
     const auto newTimePoint = std::chrono::steady_clock::now();
@@ -101,18 +127,17 @@ auto kawe::EventProvider::getElapsedTime() noexcept -> std::chrono::nanoseconds
 auto kawe::EventProvider::callback_eventClose(::GLFWwindow *) -> void
 {
     // ::glfwSetWindowShouldClose(window, false);
-    s_instance->m_buffer_events.emplace_back(event::Disconnected<event::Window>{});
+    s_instance->capture(event::Disconnected<event::Window>{});
 }
 
 auto kawe::EventProvider::callback_eventResized(GLFWwindow *, int w, int h) -> void
 {
-    s_instance->m_buffer_events.emplace_back(event::ResizeWindow{w, h});
+    s_instance->capture(event::ResizeWindow{w, h});
 }
 
 auto kawe::EventProvider::callback_eventMoved(GLFWwindow *, int x, int y) -> void
 {
-    s_instance->m_buffer_events.emplace_back(
-        event::Moved<event::Window>{event::Window{}, static_cast<double>(x), static_cast<double>(y)});
+    s_instance->capture(event::Moved<event::Window>{event::Window{}, static_cast<double>(x), static_cast<double>(y)});
 }
 
 auto kawe::EventProvider::callback_eventKeyBoard(GLFWwindow *, int key, int scancode, int action, int mods) -> void
@@ -128,11 +153,9 @@ auto kawe::EventProvider::callback_eventKeyBoard(GLFWwindow *, int key, int scan
     };
     // clang-format on
     switch (action) {
-    case GLFW_PRESS: s_instance->m_buffer_events.emplace_back(event::Pressed<event::Key>{k}); break;
-    case GLFW_RELEASE:
-        s_instance->m_buffer_events.emplace_back(event::Released<event::Key>{k});
-        break;
-        // case GLFW_REPEAT: s_instance->m_buffer_events.emplace_back(???{ key }); break; // todo
+    case GLFW_PRESS: s_instance->capture(event::Pressed<event::Key>{k}); break;
+    case GLFW_RELEASE: s_instance->capture(event::Released<event::Key>{k}); break;
+        // case GLFW_REPEAT: s_instance->capture(???{ key }); break; // todo
         // default: std::abort(); break;
     };
 }
@@ -142,12 +165,10 @@ auto kawe::EventProvider::callback_eventMousePressed(GLFWwindow *, int button, i
 {
     switch (action) {
     case GLFW_PRESS:
-        s_instance->m_buffer_events.emplace_back(
-            event::Pressed<event::MouseButton>{event::MouseButton::toButton(button), {}});
+        s_instance->capture(event::Pressed<event::MouseButton>{event::MouseButton::toButton(button), {}});
         break;
     case GLFW_RELEASE:
-        s_instance->m_buffer_events.emplace_back(
-            event::Released<event::MouseButton>{event::MouseButton::toButton(button), {}});
+        s_instance->capture(event::Released<event::MouseButton>{event::MouseButton::toButton(button), {}});
         break;
         // todo :
         // default: std::abort(); break;
@@ -156,30 +177,30 @@ auto kawe::EventProvider::callback_eventMousePressed(GLFWwindow *, int button, i
 
 auto kawe::EventProvider::callback_eventMouseMoved(GLFWwindow *, double x, double y) -> void
 {
-    s_instance->m_buffer_events.emplace_back(event::Moved<event::Mouse>{event::Mouse{}, x, y});
+    s_instance->capture(event::Moved<event::Mouse>{event::Mouse{}, x, y});
 }
 
 auto kawe::EventProvider::callback_char(GLFWwindow *, unsigned int codepoint) -> void
 {
-    s_instance->m_buffer_events.emplace_back(event::Character{codepoint});
+    s_instance->capture(event::Character{codepoint});
 }
 
 auto kawe::EventProvider::callback_scroll(GLFWwindow *, double xoffset, double yoffset) -> void
 {
-    s_instance->m_buffer_events.emplace_back(event::MouseScroll{xoffset, yoffset});
+    s_instance->capture(event::MouseScroll{xoffset, yoffset});
 }
 
 auto kawe::EventProvider::callback_maximaze(GLFWwindow *, int value) -> void
 {
-    s_instance->m_buffer_events.emplace_back(event::MaximazeWindow{static_cast<bool>(value)});
+    s_instance->capture(event::MaximazeWindow{static_cast<bool>(value)});
 }
 
 auto kawe::EventProvider::callback_minimaze(GLFWwindow *, int value) -> void
 {
-    s_instance->m_buffer_events.emplace_back(event::MinimazeWindow{static_cast<bool>(value)});
+    s_instance->capture(event::MinimazeWindow{static_cast<bool>(value)});
 }
 
 auto kawe::EventProvider::callback_focus(GLFWwindow *, int value) -> void
 {
-    s_instance->m_buffer_events.emplace_back(event::FocusWindow{static_cast<bool>(value)});
+    s_instance->capture(event::FocusWindow{static_cast<bool>(value)});
 }
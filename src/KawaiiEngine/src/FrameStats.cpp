@@ -0,0 +1,119 @@
+#include <fstream>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "FrameStats.hpp"
+
+namespace {
+
+constexpr auto PERCENTILES = std::array{0.5, 0.9, 0.99};
+
+auto to_us(std::uint64_t nanoseconds) -> double { return static_cast<double>(nanoseconds) / 1'000.0; }
+
+} // namespace
+
+auto kawe::FrameStats::end_frame() -> void
+{
+    const auto now = Clock::now();
+    if (m_frame_start.has_value()) { record_frame(now - *m_frame_start); }
+    m_frame_start = now;
+}
+
+auto kawe::FrameStats::record_frame(std::chrono::nanoseconds frame_time) -> void
+{
+    m_last_frame = frame_time;
+    m_frames.record(static_cast<std::uint64_t>(std::max(frame_time.count(), std::int64_t{0})));
+    if (frame_time > m_budget) { m_hitches++; }
+
+    m_history[m_history_next] = static_cast<float>(frame_time.count()) / 1'000'000.0f;
+    m_history_next = (m_history_next + 1) % HISTORY_SIZE;
+
+    // note : a system not run during the frame is not recorded, it would only drag its percentiles to zero
+    for (auto &section : std::span{m_sections.data(), m_section_count}) {
+        if (section.calls == 0) { continue; }
+        section.last = section.accumulated;
+        section.histogram.record(static_cast<std::uint64_t>(section.accumulated.count()));
+        section.accumulated = {};
+        section.calls = 0;
+    }
+}
+
+auto kawe::FrameStats::reset() -> void
+{
+    m_frames.reset();
+    m_history_next = 0;
+    m_hitches = 0;
+    for (auto &section : std::span{m_sections.data(), m_section_count}) {
+        section.histogram.reset();
+        section.last = {};
+    }
+}
+
+auto kawe::FrameStats::section(std::string_view name) -> Section &
+{
+    const auto sections = std::span{m_sections.data(), m_section_count};
+    if (const auto found = std::ranges::find(sections, name, &Section::name); found != sections.end()) {
+        return *found;
+    }
+
+    // note : once full, the sections registered are gathered in a slot of their own, the others keep their names
+    if (m_section_count >= MAX_SECTIONS) {
+        auto &others = m_sections[MAX_SECTIONS];
+        others.name = OTHERS_NAME;
+        m_section_count = MAX_SECTIONS + 1;
+        return others;
+    }
+
+    auto &added = m_sections[m_section_count++];
+    added.name = name;
+    return added;
+}
+
+auto kawe::FrameStats::exportTo(const std::filesystem::path &path) const -> bool
+{
+    std::error_code err;
+    if (path.has_parent_path()) { std::filesystem::create_directories(path.parent_path(), err); }
+
+    std::ofstream file{path};
+    if (!file.is_open()) { return false; }
+
+    const auto budget = static_cast<std::uint64_t>(m_budget.count());
+
+    if (path.extension() == ".csv") {
+        file << "name,count,mean_us,p50_us,p90_us,p99_us,max_us,hitches\n";
+        const auto write_row = [&file](std::string_view name, const TimeHistogram &histogram, std::uint64_t hitches) {
+            file << fmt::format(
+                "{},{},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{}\n",
+                name,
+                histogram.count(),
+                histogram.mean() / 1'000.0,
+                to_us(histogram.percentile(PERCENTILES[0])),
+                to_us(histogram.percentile(PERCENTILES[1])),
+                to_us(histogram.percentile(PERCENTILES[2])),
+                to_us(histogram.max()),
+                hitches);
+        };
+
+        write_row("frame", m_frames, m_hitches);
+        for (const auto &section : getSections()) { write_row(section.name, section.histogram, 0); }
+        return file.good();
+    }
+
+    const auto to_json = [](const TimeHistogram &histogram) {
+        return nlohmann::json{
+            {"count", histogram.count()},
+            {"mean_us", histogram.mean() / 1'000.0},
+            {"p50_us", to_us(histogram.percentile(PERCENTILES[0]))},
+            {"p90_us", to_us(histogram.percentile(PERCENTILES[1]))},
+            {"p99_us", to_us(histogram.percentile(PERCENTILES[2]))},
+            {"max_us", to_us(histogram.max())}};
+    };
+
+    auto out = nlohmann::json{{"budget_us", to_us(budget)}, {"hitches", m_hitches}, {"frame", to_json(m_frames)}};
+    auto &systems = out["systems"] = nlohmann::json::object();
+    for (const auto &section : getSections()) { systems[std::string{section.name}] = to_json(section.histogram); }
+
+    file << out.dump(4);
+    return file.good();
+}
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <fstream>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "Profiler.hpp"
+
+thread_local std::uint32_t kawe::Profiler::t_depth = 0;
+
+kawe::Profiler::Profiler() :
+    m_frame_begin{now()}, m_calibration_ticks{m_frame_begin}, m_calibration_time{std::chrono::steady_clock::now()}
+{
+}
+
+auto kawe::Profiler::get() -> Profiler &
+{
+    static Profiler instance;
+    return instance;
+}
+
+auto kawe::Profiler::push(const Zone &zone) -> void
+{
+    auto &thread = buffer();
+    if (!thread.zones.push(zone.name, zone.begin, zone.end, zone.depth, thread.id)) { thread.dropped++; }
+}
+
+auto kawe::Profiler::buffer() -> ThreadBuffer &
+{
+    // note : the registry keeps the buffer alive once the thread exits, until its last zones are drained
+    thread_local const auto local = [this] {
+        auto created = std::make_shared<ThreadBuffer>();
+        std::lock_guard lock{m_threads_mutex};
+        created->id = m_next_thread_id++;
+        created->name = fmt::format("thread {}", created->id);
+        m_threads.push_back(created);
+        return created;
+    }();
+    return *local;
+}
+
+auto kawe::Profiler::setThreadName(std::string name) -> void
+{
+    // note : no buffer is needed when the zones are compiled out
+    if constexpr (!isEnabled()) { return; }
+
+    auto &thread = buffer();
+    std::lock_guard lock{m_threads_mutex};
+    thread.name = std::move(name);
+}
+
+auto kawe::Profiler::endFrame() -> void
+{
+    const auto frame_end = now();
+    calibrate();
+
+    auto &frame = m_frames[m_frame_count % FRAME_HISTORY];
+    if (!m_paused) {
+        frame.begin = m_frame_begin;
+        frame.end = frame_end;
+        // note : the vector of the overwritten frame is reused, no allocation once the history is full
+        frame.zones.clear();
+    }
+
+    std::lock_guard lock{m_threads_mutex};
+    for (const auto &thread : m_threads) {
+        while (const auto zone = thread->zones.front()) {
+            if (!m_paused) { frame.zones.push_back(*zone); }
+            thread->zones.pop();
+        }
+        m_dropped += thread->dropped.exchange(0);
+    }
+    std::erase_if(m_threads, [](const auto &thread) { return thread.use_count() == 1 && thread->zones.empty(); });
+
+    if (!m_paused) { m_frame_count++; }
+    m_frame_begin = frame_end;
+}
+
+auto kawe::Profiler::getFrames() const -> std::vector<const Frame *>
+{
+    const auto count = std::min(m_frame_count, FRAME_HISTORY);
+
+    std::vector<const Frame *> frames;
+    frames.reserve(count);
+    for (auto i = m_frame_count - count; i != m_frame_count; i++) { frames.push_back(&m_frames[i % FRAME_HISTORY]); }
+    return frames;
+}
+
+auto kawe::Profiler::getThreads() const -> std::vector<ThreadInfo>
+{
+    std::lock_guard lock{m_threads_mutex};
+    std::vector<ThreadInfo> threads;
+    for (const auto &thread : m_threads) { threads.push_back({thread->id, thread->name}); }
+    return threads;
+}
+
+auto kawe::Profiler::calibrate() -> void
+{
+    // note : the ratio is measured since the start, it gets more precise the longer the engine runs
+    const auto ticks = now() - m_calibration_ticks;
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - m_calibration_time);
+    if (ticks != 0 && elapsed.count() > 0.0) { m_ns_per_tick = elapsed.count() / static_cast<double>(ticks); }
+}
+
+auto kawe::Profiler::exportChromeTrace(const std::filesystem::path &path) const -> bool
+{
+    std::error_code err;
+    if (path.has_parent_path()) { std::filesystem::create_directories(path.parent_path(), err); }
+
+    std::ofstream file{path};
+    if (!file.is_open()) { return false; }
+
+    const auto frames = getFrames();
+    const auto origin = frames.empty() ? 0 : frames.front()->begin;
+    const auto to_us = [this, origin](std::uint64_t ticks) { return toNanoseconds(ticks - origin) / 1'000.0; };
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    auto first = true;
+    const auto separator = [&first] {
+        const auto out = first ? "" : ",\n";
+        first = false;
+        return out;
+    };
+
+    for (const auto &thread : getThreads()) {
+        file << fmt::format(
+            R"({}{{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":{}}}}})",
+            separator(),
+            thread.id,
+            nlohmann::json(thread.name).dump());
+    }
+
+    for (const auto *frame : frames) {
+        // note : zones closing after the frame started may have been opened before it
+        for (const auto &zone : frame->zones) {
+            if (zone.begin < origin) { continue; }
+            file << fmt::format(
+                R"({}{{"name":{},"ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                separator(),
+                nlohmann::json(zone.name).dump(),
+                zone.thread,
+                to_us(zone.begin),
+                toNanoseconds(zone.end - zone.begin) / 1'000.0);
+        }
+    }
+
+    file << "\n]}\n";
+    return file.good();
+}
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <iterator>
+
+#include "Replay.hpp"
+
+auto kawe::Replay::on_frame_end() -> void
+{
+    if (m_seek_request.has_value()) {
+        const auto target = *m_seek_request;
+        m_seek_request.reset();
+        return seek(target);
+    }
+
+    if (m_provider.getState() != EventProvider::State::PLAYBACK) {
+        if (isSeeking()) { finishSeek(); }
+        return;
+    }
+
+    const auto position = m_provider.getPlaybackPosition();
+    if (isSeeking() && position >= *m_seek_target) { finishSeek(); }
+
+    // note : a keyframe can only be taken between two events of the log, not in the middle of a split TimeElapsed
+    if (!m_provider.isPlaybackAtEventBoundary()) { return; }
+
+    if (m_keyframes.empty() || position >= m_keyframes.back().event_index + KEYFRAME_INTERVAL) {
+        m_keyframes.push_back(WorldSnapshot::take(m_world, m_ctx, m_timers, position));
+    }
+}
+
+auto kawe::Replay::reset() -> void
+{
+    m_keyframes.clear();
+    m_seek_request.reset();
+    if (isSeeking()) { finishSeek(); }
+}
+
+auto kawe::Replay::seek(std::size_t event_index) -> void
+{
+    if (m_keyframes.empty()) {
+        spdlog::warn("Replay: no keyframe to seek from");
+        return;
+    }
+
+    if (const auto limit = getSeekLimit(); event_index > limit) {
+        spdlog::info("Replay: the event {} is not reached yet, seeking to the event {}", event_index, limit);
+        event_index = limit;
+    }
+
+    const auto found = std::upper_bound(
+        m_keyframes.begin(), m_keyframes.end(), event_index, [](auto index, const auto &keyframe) {
+            return index < keyframe.event_index;
+        });
+    const auto &keyframe = found == m_keyframes.begin() ? *found : *std::prev(found);
+
+    keyframe.restore(m_world, m_ctx, m_timers);
+    if (!m_provider.seekPlayback(keyframe.event_index)) {
+        spdlog::error("Replay: failed to seek the log to the event {}", keyframe.event_index);
+        return;
+    }
+
+    if (event_index <= keyframe.event_index) {
+        if (isSeeking()) { finishSeek(); }
+        return;
+    }
+
+    if (!isSeeking()) { m_mode_before_seek = m_provider.getPlaybackMode(); }
+    m_seek_target = event_index;
+    m_provider.setPlaybackMode(EventProvider::PlaybackMode::FAST_FORWARD);
+}
+
+auto kawe::Replay::finishSeek() -> void
+{
+    m_provider.setPlaybackMode(m_mode_before_seek);
+    m_seek_target.reset();
+}
@@ -4,14 +4,29 @@
 
 auto kawe::System::on_time_elapsed_render(const action::Render<Render::Layout::SCENE> &) -> void
 {
+    const auto measured = stats.measure("render");
+
     const auto render = [this]<bool has_ebo, bool has_texture, bool is_pickable>(
                             const CameraData &cam,
-                            [[maybe_unused]] const entt::entity &e,
+                            const entt::entity &e,
                             const Render::VAO &vao,
                             const Position3f &pos,
                             const Rotation3f &rot,
                             const Scale3f &scale,
                             const Texture2D &texture) {
+        // note : the geometry is drawn once the upload thread is done with it, and attached again to be seen here
+        if (!vao.attached) {
+            if (!is_uploaded<
+                    Render::EBO,
+                    Render::VBO<Render::VAO::Attribute::POSITION>,
+                    Render::VBO<Render::VAO::Attribute::COLOR>,
+                    Render::VBO<Render::VAO::Attribute::TEXTURE_2D>,
+                    Render::VBO<Render::VAO::Attribute::NORMALS>>(e)) {
+                return;
+            }
+            Render::attach(my_world, e);
+        }
+
         auto model = glm::dmat4(1.0);
         model = glm::translate(model, pos.component);
         model = glm::rotate(model, glm::radians(rot.component.x), glm::dvec3(1.0, 0.0, 0.0));
@@ -22,13 +37,19 @@ auto kawe::System::on_time_elapsed_render(const action::Render<Render::Layout::S
         if constexpr (!is_pickable) {
             // note : not optimized at all !!! bad bad bad
             // or is it ?
-            vao.shader_program->use();
+            gl_state.useProgram(vao.shader_program->getId());
             vao.shader_program->setUniform("view", cam.view);
             vao.shader_program->setUniform("projection", cam.projection);
             vao.shader_program->setUniform("model", model);
 
             if constexpr (has_texture) {
-                CALL_OPEN_GL(glBindTexture(GL_TEXTURE_2D, texture.textureID));
+                // note : the size on screen decides the levels of the image kept resident, from the next frame
+                textures.request(texture.image, projected_size(cam, e, model));
+
+                // note : the images of the same size share an array texture, only the layer changes
+                const auto binding = textures.getBinding(texture.image);
+                gl_state.bindTexture(GL_TEXTURE_2D_ARRAY, binding.object);
+                vao.shader_program->setUniform("texLayer", binding.layer);
 
                 // setting light properties.
                 auto light_count = static_cast<unsigned int>(my_world.size<PointLight>());
@@ -62,21 +83,19 @@ auto kawe::System::on_time_elapsed_render(const action::Render<Render::Layout::S
             const auto g = static_cast<double>((static_cast<std::uint32_t>(e) & 0x0000FF00u) >> 8u);
             const auto b = static_cast<double>((static_cast<std::uint32_t>(e) & 0x00FF0000u) >> 16u);
 
-            (*found)->use();
+            gl_state.useProgram((*found)->getId());
             (*found)->setUniform("view", cam.view);
             (*found)->setUniform("projection", cam.projection);
             (*found)->setUniform("model", model);
             (*found)->setUniform("object_color", glm::dvec4{r / 255.0, g / 255.0, b / 255.0, 1.0});
         }
 
-        CALL_OPEN_GL(::glBindVertexArray(vao.object));
+        gl_state.bindVertexArray(vao.object);
         if constexpr (has_ebo) {
             CALL_OPEN_GL(::glDrawElements(static_cast<GLenum>(vao.mode), vao.count, GL_UNSIGNED_INT, 0));
         } else {
             CALL_OPEN_GL(::glDrawArrays(static_cast<GLenum>(vao.mode), 0, vao.count));
         }
-
-        if constexpr (!is_pickable && has_texture) { CALL_OPEN_GL(glBindTexture(GL_TEXTURE_2D, 0)); }
     };
 
     const auto render_all = [ this, &render ]<typename... With>(const CameraData &cam)
@@ -359,8 +378,10 @@ auto kawe::System::on_time_elapsed_render(const action::Render<Render::Layout::S
         && !ImGui::IsWindowFocused(ImGuiFocusedFlags_AnyWindow)) {
         const auto &list_pickable = my_world.view<Pickable, Render::VAO>();
         if (list_pickable.size_hint() != 0) {
-            glClearColor(1, 1, 1, 1);
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            const auto gpu_measured = gpu_timers.measure(GpuTimers::Pass::PICKING);
+
+            gl_state.clearColor(1.0f, 1.0f, 1.0f, 1.0f);
+            CALL_OPEN_GL(::glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
 
             for (auto &i : my_world.view<CameraData>()) {
                 const auto &camera = my_world.get<CameraData>(i);
@@ -371,25 +392,25 @@ auto kawe::System::on_time_elapsed_render(const action::Render<Render::Layout::S
                     static_cast<GLint>(cam_viewport.y * window_size.y),
                     static_cast<GLsizei>(cam_viewport.w * window_size.x),
                     static_cast<GLsizei>(cam_viewport.h * window_size.y)};
-                ::glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+                gl_state.viewport(viewport[0], viewport[1], viewport[2], viewport[3]);
 
                 render_all.operator()<Pickable>(camera);
             }
             // note : is it required ?
-            glFlush();
-            glFinish();
+            CALL_OPEN_GL(::glFlush());
+            CALL_OPEN_GL(::glFinish());
 
-            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            CALL_OPEN_GL(::glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
 
             std::array<std::uint8_t, 4> data{0, 0, 0, 0};
-            glReadPixels(
+            CALL_OPEN_GL(::glReadPixels(
                 static_cast<GLint>(ctx.mouse_pos_when_pressed.x),
                 static_cast<GLint>(ctx.mouse_pos_when_pressed.y),
                 1,
                 1,
                 GL_RGBA,
                 GL_UNSIGNED_BYTE,
-                data.data());
+                data.data()));
 
             const int pickedID = data[0] + data[1] * 256 + data[2] * 256 * 256;
             spdlog::debug("pick = {}", pickedID);
@@ -411,8 +432,10 @@ auto kawe::System::on_time_elapsed_render(const action::Render<Render::Layout::S
     // this will render during one frame what the engine see when u try to pick an object
     else {
 #endif
-        glClearColor(ctx.clear_color.r, ctx.clear_color.g, ctx.clear_color.b, ctx.clear_color.a);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        const auto gpu_measured = gpu_timers.measure(GpuTimers::Pass::SCENE);
+
+        gl_state.clearColor(ctx.clear_color.r, ctx.clear_color.g, ctx.clear_color.b, ctx.clear_color.a);
+        CALL_OPEN_GL(::glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
 
         for (auto &i : my_world.view<CameraData>()) {
             const auto &camera = my_world.get<CameraData>(i);
@@ -425,7 +448,7 @@ auto kawe::System::on_time_elapsed_render(const action::Render<Render::Layout::S
                 static_cast<GLint>(cam_viewport.y * window_size.y),
                 static_cast<GLsizei>(cam_viewport.w * window_size.x),
                 static_cast<GLsizei>(cam_viewport.h * window_size.y)};
-            ::glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+            gl_state.viewport(viewport[0], viewport[1], viewport[2], viewport[3]);
 
             render_all(camera);
         }
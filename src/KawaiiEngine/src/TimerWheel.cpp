@@ -0,0 +1,180 @@
+#include <algorithm>
+
+#include "TimerWheel.hpp"
+
+auto kawe::TimerWheel::schedule(duration delay, Callback callback, duration period) -> Handle
+{
+    std::uint32_t index{};
+    if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+    } else {
+        index = static_cast<std::uint32_t>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+
+    auto &node = m_nodes[index];
+    node.callback = std::move(callback);
+    // note : a timer can not expire during the tick it has been scheduled on
+    node.expire_tick = m_current_tick + static_cast<std::uint64_t>(std::max<duration::rep>(delay.count(), 1));
+    node.period = static_cast<std::uint64_t>(std::max<duration::rep>(period.count(), 0));
+    node.state = NodeState::PENDING;
+    m_active++;
+
+    insert(index);
+
+    return {index, node.generation};
+}
+
+auto kawe::TimerWheel::cancel(const Handle &handle) noexcept -> bool
+{
+    const auto node = get(handle);
+    if (node == nullptr) { return false; }
+
+    switch (node->state) {
+    case NodeState::PENDING:
+        unlink(handle.index);
+        release(handle.index);
+        return true;
+    case NodeState::FIRING:
+        // the node is released by `tick` once its callback returned
+        node->state = NodeState::CANCELLED;
+        return true;
+    default: return false;
+    }
+}
+
+auto kawe::TimerWheel::is_pending(const Handle &handle) const noexcept -> bool
+{
+    if (handle.index >= m_nodes.size()) { return false; }
+    const auto &node = m_nodes[handle.index];
+    return node.generation == handle.generation && node.state == NodeState::PENDING;
+}
+
+auto kawe::TimerWheel::advance(std::chrono::steady_clock::duration world_time) -> void
+{
+    m_remainder += world_time;
+    const auto ticks = std::chrono::duration_cast<duration>(m_remainder);
+    if (ticks.count() <= 0) { return; }
+    m_remainder -= ticks;
+
+    for (auto i = ticks.count(); i != 0; i--) {
+        if (m_active == 0) {
+            // nothing can fire, jump straight to the end of the interval
+            m_current_tick += static_cast<std::uint64_t>(i);
+            return;
+        }
+        tick();
+    }
+}
+
+auto kawe::TimerWheel::clear() noexcept -> void
+{
+    // note : the nodes are released as by `cancel` rather than dropped, so a handle kept from before does not match
+    //        the timers scheduled after
+    for (std::uint32_t index = 0; index != m_nodes.size(); index++) {
+        switch (m_nodes[index].state) {
+        case NodeState::PENDING:
+            unlink(index);
+            release(index);
+            break;
+        case NodeState::FIRING: m_nodes[index].state = NodeState::CANCELLED; break;
+        default: break;
+        }
+    }
+}
+
+auto kawe::TimerWheel::get(const Handle &handle) noexcept -> Node *
+{
+    if (handle.index >= m_nodes.size()) { return nullptr; }
+    auto &node = m_nodes[handle.index];
+    return node.generation == handle.generation && node.state != NodeState::FREE ? &node : nullptr;
+}
+
+auto kawe::TimerWheel::insert(std::uint32_t index) noexcept -> void
+{
+    auto &node = m_nodes[index];
+
+    const auto delta = std::min(node.expire_tick - std::min(node.expire_tick, m_current_tick), MAX_DELTA);
+    // note : timers further than the wheel range are parked in the last level and re-inserted on cascade
+    const auto expire = m_current_tick + delta;
+
+    std::uint32_t level = 0;
+    while (level + 1 < LEVEL_COUNT && delta >= (std::uint64_t{1} << (SLOT_BITS * (level + 1)))) { level++; }
+
+    const auto slot = level * SLOT_COUNT + static_cast<std::uint32_t>((expire >> (SLOT_BITS * level)) & SLOT_MASK);
+
+    node.slot = slot;
+    node.prev = NIL;
+    node.next = m_slots[slot];
+    if (node.next != NIL) { m_nodes[node.next].prev = index; }
+    m_slots[slot] = index;
+}
+
+auto kawe::TimerWheel::unlink(std::uint32_t index) noexcept -> void
+{
+    auto &node = m_nodes[index];
+
+    if (node.prev != NIL) {
+        m_nodes[node.prev].next = node.next;
+    } else {
+        m_slots[node.slot] = node.next;
+    }
+    if (node.next != NIL) { m_nodes[node.next].prev = node.prev; }
+
+    node.prev = NIL;
+    node.next = NIL;
+    node.slot = NIL;
+}
+
+auto kawe::TimerWheel::release(std::uint32_t index) noexcept -> void
+{
+    auto &node = m_nodes[index];
+    node.callback = nullptr;
+    node.state = NodeState::FREE;
+    node.generation++;
+    m_free.push_back(index);
+    m_active--;
+}
+
+auto kawe::TimerWheel::cascade(std::uint32_t level) noexcept -> void
+{
+    const auto slot = level * SLOT_COUNT
+                      + static_cast<std::uint32_t>((m_current_tick >> (SLOT_BITS * level)) & SLOT_MASK);
+
+    auto index = m_slots[slot];
+    m_slots[slot] = NIL;
+    while (index != NIL) {
+        const auto next = m_nodes[index].next;
+        insert(index);
+        index = next;
+    }
+}
+
+auto kawe::TimerWheel::tick() -> void
+{
+    m_current_tick++;
+
+    for (std::uint32_t level = 1; level != LEVEL_COUNT; level++) {
+        if (((m_current_tick >> (SLOT_BITS * (level - 1))) & SLOT_MASK) != 0) { break; }
+        cascade(level);
+    }
+
+    const auto slot = static_cast<std::uint32_t>(m_current_tick & SLOT_MASK);
+    while (m_slots[slot] != NIL) {
+        const auto index = m_slots[slot];
+        unlink(index);
+
+        auto &node = m_nodes[index];
+        node.state = NodeState::FIRING;
+        node.callback();
+
+        if (node.state == NodeState::FIRING && node.period != 0) {
+            node.state = NodeState::PENDING;
+            node.expire_tick = m_current_tick + node.period;
+            insert(index);
+        } else {
+            release(index);
+        }
+    }
+}
@@ -0,0 +1,629 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iterator>
+#include <utility>
+
+#include "binary/EventLog.hpp"
+#include "helpers/Compression.hpp"
+#include "json/JsonEventReader.hpp"
+#include "json/SerializeEvent.hpp"
+
+namespace {
+
+using namespace kawe;
+using binary::EventLogFormat;
+
+static_assert(std::variant_size_v<event::Event> < 0x80, "the tag must keep a bit for the flags");
+
+// the coordinates are stored as integer deltas, or as raw doubles if they are not integral
+constexpr std::uint8_t TAG_INTEGRAL = 0x80;
+constexpr std::uint8_t TAG_INDEX_MASK = 0x7F;
+
+constexpr std::size_t CONVERTER_BLOCK_SIZE = 4096;
+
+auto as_integral(double value, std::int64_t &out) noexcept -> bool
+{
+    if (!(std::abs(value) < 0x1p52)) { return false; }
+    const auto integral = static_cast<std::int64_t>(value);
+    if (static_cast<double>(integral) != value) { return false; }
+    out = integral;
+    return true;
+}
+
+auto zigzag(std::int64_t value) noexcept -> std::uint64_t
+{
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+auto unzigzag(std::uint64_t value) noexcept -> std::int64_t
+{
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+struct ByteWriter {
+    std::vector<std::uint8_t> &out;
+
+    auto u8(std::uint8_t value) -> void { out.push_back(value); }
+
+    auto u16(std::uint16_t value) -> void
+    {
+        for (auto i = 0u; i != sizeof(value); i++) { out.push_back(static_cast<std::uint8_t>(value >> (8u * i))); }
+    }
+
+    auto u32(std::uint32_t value) -> void
+    {
+        for (auto i = 0u; i != sizeof(value); i++) { out.push_back(static_cast<std::uint8_t>(value >> (8u * i))); }
+    }
+
+    auto u64(std::uint64_t value) -> void
+    {
+        for (auto i = 0u; i != sizeof(value); i++) { out.push_back(static_cast<std::uint8_t>(value >> (8u * i))); }
+    }
+
+    auto varint(std::uint64_t value) -> void
+    {
+        for (; value >= 0x80; value >>= 7) { out.push_back(static_cast<std::uint8_t>(value | 0x80)); }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    auto svarint(std::int64_t value) -> void { varint(zigzag(value)); }
+
+    auto f32(float value) -> void { u32(std::bit_cast<std::uint32_t>(value)); }
+
+    auto f64(double value) -> void { u64(std::bit_cast<std::uint64_t>(value)); }
+};
+
+struct ByteReader {
+    std::span<const std::uint8_t> in;
+    std::size_t &cursor;
+    bool ok = true;
+
+    auto u8() noexcept -> std::uint8_t
+    {
+        if (cursor >= in.size()) {
+            ok = false;
+            return 0;
+        }
+        return in[cursor++];
+    }
+
+    template<typename T>
+    auto fixed() noexcept -> T
+    {
+        T value{};
+        for (auto i = 0u; i != sizeof(T); i++) { value |= static_cast<T>(static_cast<T>(u8()) << (8u * i)); }
+        return value;
+    }
+
+    auto varint() noexcept -> std::uint64_t
+    {
+        std::uint64_t value{};
+        for (auto shift = 0u; shift < 64; shift += 7) {
+            const auto byte = u8();
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) { return value; }
+        }
+        ok = false;
+        return value;
+    }
+
+    auto svarint() noexcept -> std::int64_t { return unzigzag(varint()); }
+
+    auto f32() noexcept -> float { return std::bit_cast<float>(fixed<std::uint32_t>()); }
+
+    auto f64() noexcept -> double { return std::bit_cast<double>(fixed<std::uint64_t>()); }
+};
+
+struct Encoder {
+    ByteWriter &out;
+    EventLogFormat::DeltaState &state;
+    std::uint8_t &tag;
+
+    // sources
+
+    auto source(const event::Window &window) -> void { out.svarint(window.id); }
+
+    auto source(const event::Key &key) -> void
+    {
+        out.u8(static_cast<std::uint8_t>(
+            (key.alt ? 1u : 0u) | (key.control ? 2u : 0u) | (key.system ? 4u : 0u) | (key.shift ? 8u : 0u)));
+        out.svarint(key.scancode);
+        out.svarint(magic_enum::enum_integer(key.keycode));
+    }
+
+    auto source(const event::MouseButton &button) -> void { out.svarint(magic_enum::enum_integer(button.button)); }
+
+    auto source(const event::Joystick &joystick) -> void
+    {
+        out.svarint(joystick.id);
+        for (const auto &axis : joystick.axes) { out.f32(axis); }
+        std::uint64_t buttons{};
+        for (auto i = 0ul; i != joystick.buttons.size(); i++) {
+            if (joystick.buttons[i]) { buttons |= std::uint64_t{1} << i; }
+        }
+        out.varint(buttons);
+    }
+
+    auto source(const event::JoystickButton &button) -> void
+    {
+        out.svarint(button.id);
+        out.varint(static_cast<std::uint64_t>(button.button));
+    }
+
+    auto source(const event::JoystickAxis &axis) -> void
+    {
+        out.svarint(axis.id);
+        out.varint(static_cast<std::uint64_t>(axis.axis));
+        out.f32(axis.value);
+    }
+
+    auto coordinates(double x, double y, std::array<std::int64_t, 2> &previous) -> void
+    {
+        std::int64_t ix{};
+        std::int64_t iy{};
+        if (as_integral(x, ix) && as_integral(y, iy)) {
+            tag |= TAG_INTEGRAL;
+            out.svarint(ix - previous[0]);
+            out.svarint(iy - previous[1]);
+            previous = {ix, iy};
+        } else {
+            out.f64(x);
+            out.f64(y);
+        }
+    }
+
+    // events
+
+    auto operator()(const std::monostate &) -> void {}
+
+    template<typename Source>
+    auto operator()(const event::Connected<Source> &e) -> void
+    {
+        source(e.source);
+    }
+
+    template<typename Source>
+    auto operator()(const event::Disconnected<Source> &e) -> void
+    {
+        source(e.source);
+    }
+
+    template<typename Source>
+    auto operator()(const event::Pressed<Source> &e) -> void
+    {
+        source(e.source);
+    }
+
+    template<typename Source>
+    auto operator()(const event::Released<Source> &e) -> void
+    {
+        source(e.source);
+    }
+
+    auto operator()(const event::Moved<event::Window> &e) -> void
+    {
+        source(e.source);
+        coordinates(e.x, e.y, state.window);
+    }
+
+    auto operator()(const event::Moved<event::Mouse> &e) -> void { coordinates(e.x, e.y, state.mouse); }
+
+    auto operator()(const event::Moved<event::JoystickAxis> &e) -> void
+    {
+        source(e.source);
+        out.f64(e.x);
+        out.f64(e.y);
+    }
+
+    auto operator()(const event::ResizeWindow &e) -> void
+    {
+        out.svarint(e.width);
+        out.svarint(e.height);
+    }
+
+    auto operator()(const event::MaximazeWindow &e) -> void { out.u8(e.maximazed); }
+    auto operator()(const event::MinimazeWindow &e) -> void { out.u8(e.minimazed); }
+    auto operator()(const event::FocusWindow &e) -> void { out.u8(e.focused); }
+
+    auto operator()(const event::TimeElapsed &e) -> void
+    {
+        const auto elapsed = std::chrono::nanoseconds{e.elapsed}.count();
+        const auto world_time = std::chrono::nanoseconds{e.world_time}.count();
+        out.svarint(elapsed - state.elapsed);
+        out.svarint(world_time - state.world_time);
+        out.varint(e.stack);
+        state.elapsed = elapsed;
+        state.world_time = world_time;
+    }
+
+    auto operator()(const event::Character &e) -> void { out.varint(e.codepoint); }
+
+    auto operator()(const event::MouseScroll &e) -> void
+    {
+        std::int64_t ix{};
+        std::int64_t iy{};
+        if (as_integral(e.x, ix) && as_integral(e.y, iy)) {
+            tag |= TAG_INTEGRAL;
+            out.svarint(ix);
+            out.svarint(iy);
+        } else {
+            out.f64(e.x);
+            out.f64(e.y);
+        }
+    }
+};
+
+struct Decoder {
+    ByteReader &in;
+    EventLogFormat::DeltaState &state;
+    bool integral;
+
+    // sources
+
+    auto source(event::Window &window) -> void { window.id = static_cast<int>(in.svarint()); }
+
+    auto source(event::Key &key) -> void
+    {
+        const auto modifiers = in.u8();
+        key.alt = (modifiers & 1u) != 0;
+        key.control = (modifiers & 2u) != 0;
+        key.system = (modifiers & 4u) != 0;
+        key.shift = (modifiers & 8u) != 0;
+        key.scancode = static_cast<int>(in.svarint());
+        key.keycode = static_cast<event::Key::Code>(in.svarint());
+    }
+
+    auto source(event::MouseButton &button) -> void
+    {
+        button.button = event::MouseButton::toButton(static_cast<int>(in.svarint()));
+    }
+
+    auto source(event::Joystick &joystick) -> void
+    {
+        joystick.id = static_cast<event::Joystick::type_id>(in.svarint());
+        for (auto &axis : joystick.axes) { axis = in.f32(); }
+        const auto buttons = in.varint();
+        for (auto i = 0ul; i != joystick.buttons.size(); i++) { joystick.buttons[i] = ((buttons >> i) & 1u) != 0; }
+    }
+
+    auto source(event::JoystickButton &button) -> void
+    {
+        button.id = static_cast<event::Joystick::type_id>(in.svarint());
+        button.button = static_cast<event::Joystick::Buttons>(in.varint());
+    }
+
+    auto source(event::JoystickAxis &axis) -> void
+    {
+        axis.id = static_cast<event::Joystick::type_id>(in.svarint());
+        axis.axis = static_cast<event::Joystick::Axis>(in.varint());
+        axis.value = in.f32();
+    }
+
+    auto coordinates(double &x, double &y, std::array<std::int64_t, 2> &previous) -> void
+    {
+        if (integral) {
+            previous[0] += in.svarint();
+            previous[1] += in.svarint();
+            x = static_cast<double>(previous[0]);
+            y = static_cast<double>(previous[1]);
+        } else {
+            x = in.f64();
+            y = in.f64();
+        }
+    }
+
+    // events
+
+    auto operator()(std::monostate &) -> void {}
+
+    template<typename Source>
+    auto operator()(event::Connected<Source> &e) -> void
+    {
+        source(e.source);
+    }
+
+    template<typename Source>
+    auto operator()(event::Disconnected<Source> &e) -> void
+    {
+        source(e.source);
+    }
+
+    template<typename Source>
+    auto operator()(event::Pressed<Source> &e) -> void
+    {
+        source(e.source);
+    }
+
+    template<typename Source>
+    auto operator()(event::Released<Source> &e) -> void
+    {
+        source(e.source);
+    }
+
+    auto operator()(event::Moved<event::Window> &e) -> void
+    {
+        source(e.source);
+        coordinates(e.x, e.y, state.window);
+    }
+
+    auto operator()(event::Moved<event::Mouse> &e) -> void { coordinates(e.x, e.y, state.mouse); }
+
+    auto operator()(event::Moved<event::JoystickAxis> &e) -> void
+    {
+        source(e.source);
+        e.x = in.f64();
+        e.y = in.f64();
+    }
+
+    auto operator()(event::ResizeWindow &e) -> void
+    {
+        e.width = static_cast<int>(in.svarint());
+        e.height = static_cast<int>(in.svarint());
+    }
+
+    auto operator()(event::MaximazeWindow &e) -> void { e.maximazed = in.u8() != 0; }
+    auto operator()(event::MinimazeWindow &e) -> void { e.minimazed = in.u8() != 0; }
+    auto operator()(event::FocusWindow &e) -> void { e.focused = in.u8() != 0; }
+
+    auto operator()(event::TimeElapsed &e) -> void
+    {
+        state.elapsed += in.svarint();
+        state.world_time += in.svarint();
+        e.elapsed = std::chrono::nanoseconds{state.elapsed};
+        e.world_time = std::chrono::nanoseconds{state.world_time};
+        e.stack = static_cast<std::size_t>(in.varint());
+    }
+
+    auto operator()(event::Character &e) -> void { e.codepoint = static_cast<std::uint32_t>(in.varint()); }
+
+    auto operator()(event::MouseScroll &e) -> void
+    {
+        if (integral) {
+            e.x = static_cast<double>(in.svarint());
+            e.y = static_cast<double>(in.svarint());
+        } else {
+            e.x = in.f64();
+            e.y = in.f64();
+        }
+    }
+};
+
+template<std::size_t... I>
+auto make_event(std::size_t index, std::index_sequence<I...>) -> std::optional<event::Event>
+{
+    constexpr std::array<event::Event (*)(), sizeof...(I)> factories{
+        +[]() -> event::Event { return event::Event{std::in_place_index<I>}; }...};
+
+    if (index >= factories.size()) { return {}; }
+    return factories[index]();
+}
+
+auto read_u32(std::span<const std::uint8_t> bytes, std::size_t offset) noexcept -> std::uint32_t
+{
+    std::size_t cursor = offset;
+    ByteReader reader{bytes, cursor};
+    return reader.fixed<std::uint32_t>();
+}
+
+} // namespace
+
+auto kawe::binary::encode(std::span<const event::Event> events, std::vector<std::uint8_t> &out) -> void
+{
+    ByteWriter writer{out};
+    EventLogFormat::DeltaState state{};
+
+    for (const auto &event : events) {
+        const auto tag_position = out.size();
+        auto tag = static_cast<std::uint8_t>(event.index());
+        writer.u8(tag);
+        std::visit(Encoder{writer, state, tag}, event);
+        out[tag_position] = tag;
+    }
+}
+
+kawe::binary::EventLogWriter::EventLogWriter(const std::filesystem::path &path, bool compress) :
+    m_file{path, std::ios::binary | std::ios::trunc}, m_compress{compress}
+{
+    if (!m_file.is_open()) {
+        spdlog::error("EventLogWriter: failed to open file: {}", path.string());
+        return;
+    }
+
+    std::vector<std::uint8_t> header;
+    ByteWriter writer{header};
+    for (const auto &c : EventLogFormat::MAGIC) { writer.u8(static_cast<std::uint8_t>(c)); }
+    writer.u16(EventLogFormat::VERSION);
+    writer.u16(compress ? EventLogFormat::COMPRESSED : EventLogFormat::NONE);
+    writer.u32(0);
+
+    m_file.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size()));
+}
+
+auto kawe::binary::EventLogWriter::write(std::span<const event::Event> events) -> void
+{
+    if (events.empty() || !m_file.is_open()) { return; }
+
+    m_raw.clear();
+    encode(events, m_raw);
+
+    m_stored.clear();
+    if (m_compress) { compress_block(m_raw, m_stored); }
+    const auto &payload = m_compress && m_stored.size() < m_raw.size() ? m_stored : m_raw;
+
+    std::vector<std::uint8_t> header;
+    ByteWriter writer{header};
+    writer.u32(static_cast<std::uint32_t>(events.size()));
+    writer.u32(static_cast<std::uint32_t>(m_raw.size()));
+    writer.u32(static_cast<std::uint32_t>(payload.size()));
+
+    m_file.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size()));
+    m_file.write(reinterpret_cast<const char *>(payload.data()), static_cast<std::streamsize>(payload.size()));
+    m_count += events.size();
+}
+
+kawe::binary::EventLogReader::EventLogReader(const std::filesystem::path &path) : m_file{path}
+{
+    if (!m_file.is_open()) { return; }
+
+    const auto bytes = m_file.bytes();
+    if (bytes.size() < EventLogFormat::HEADER_SIZE
+        || !std::equal(EventLogFormat::MAGIC.begin(), EventLogFormat::MAGIC.end(), bytes.begin(), [](auto c, auto b) {
+               return static_cast<std::uint8_t>(c) == b;
+           })) {
+        spdlog::error("EventLogReader: '{}' is not an event log", path.string());
+        return;
+    }
+
+    if (const auto version = static_cast<std::uint16_t>(bytes[8] | (bytes[9] << 8)); version > EventLogFormat::VERSION) {
+        spdlog::error("EventLogReader: '{}' has an unsupported version {}", path.string(), version);
+        return;
+    }
+
+    // note : only the block headers are read here, the payloads are decoded on demand
+    auto offset = EventLogFormat::HEADER_SIZE;
+    while (offset + EventLogFormat::BLOCK_HEADER_SIZE <= bytes.size()) {
+        const auto count = read_u32(bytes, offset);
+        const auto raw_size = read_u32(bytes, offset + 4);
+        const auto stored_size = read_u32(bytes, offset + 8);
+
+        if (offset + EventLogFormat::BLOCK_HEADER_SIZE + stored_size > bytes.size() || stored_size > raw_size) {
+            spdlog::warn("EventLogReader: '{}' is truncated, {} events readable", path.string(), m_count);
+            break;
+        }
+
+        m_blocks.push_back({offset, m_count, count, raw_size, stored_size});
+        m_count += count;
+        offset += EventLogFormat::BLOCK_HEADER_SIZE + stored_size;
+    }
+
+    m_valid = true;
+}
+
+auto kawe::binary::EventLogReader::next() -> std::optional<event::Event>
+{
+    if (!m_valid || m_position == m_count) { return {}; }
+
+    while (m_decoded_in_block == m_block_count) {
+        if (m_block == m_blocks.size() || !load_block(m_block++)) {
+            m_position = m_count;
+            return {};
+        }
+    }
+
+    ByteReader reader{m_payload, m_cursor};
+    const auto tag = reader.u8();
+    auto event = make_event(tag & TAG_INDEX_MASK, std::make_index_sequence<std::variant_size_v<event::Event>>{});
+    if (event.has_value()) { std::visit(Decoder{reader, m_state, (tag & TAG_INTEGRAL) != 0}, *event); }
+
+    if (!event.has_value() || !reader.ok) {
+        spdlog::error("EventLogReader: corrupted block {}, stopping the playback", m_block - 1);
+        m_position = m_count;
+        return {};
+    }
+
+    m_decoded_in_block++;
+    m_position++;
+    return event;
+}
+
+auto kawe::binary::EventLogReader::seek(std::size_t index) -> bool
+{
+    if (!m_valid || index > m_count) { return false; }
+
+    m_position = m_count;
+    m_block = m_blocks.size();
+    m_block_count = 0;
+    m_decoded_in_block = 0;
+    if (index == m_count) { return true; }
+
+    const auto found = std::prev(std::upper_bound(
+        m_blocks.begin(), m_blocks.end(), index, [](auto i, const auto &block) { return i < block.first_event; }));
+    const auto block_index = static_cast<std::size_t>(std::distance(m_blocks.begin(), found));
+    if (!load_block(block_index)) { return false; }
+
+    m_block = block_index + 1;
+    m_position = found->first_event;
+
+    // note : the events are delta encoded, so the block is decoded from its start
+    while (m_position < index) {
+        if (!next().has_value()) { return false; }
+    }
+    return true;
+}
+
+auto kawe::binary::EventLogReader::load_block(std::size_t index) -> bool
+{
+    const auto &block = m_blocks[index];
+    const auto stored = m_file.bytes().subspan(block.offset + EventLogFormat::BLOCK_HEADER_SIZE, block.stored_size);
+
+    if (block.stored_size < block.raw_size) {
+        m_buffer.resize(block.raw_size);
+        if (!decompress_block(stored, m_buffer)) {
+            spdlog::error("EventLogReader: failed to decompress block {}", index);
+            return false;
+        }
+        m_payload = m_buffer;
+    } else {
+        // note : uncompressed blocks are decoded straight from the mapping
+        m_payload = stored;
+    }
+
+    m_cursor = 0;
+    m_state = {};
+    m_block_count = block.count;
+    m_decoded_in_block = 0;
+    return true;
+}
+
+auto kawe::binary::convert_json_to_log(const std::filesystem::path &json, const std::filesystem::path &log) -> bool
+{
+    JsonEventReader reader{json};
+    if (!reader.is_open()) { return false; }
+
+    EventLogWriter writer{log};
+    if (!writer.is_open()) { return false; }
+
+    std::vector<event::Event> block;
+    block.reserve(CONVERTER_BLOCK_SIZE);
+    while (auto event = reader.next()) {
+        block.push_back(std::move(*event));
+        if (block.size() == CONVERTER_BLOCK_SIZE) {
+            writer.write(block);
+            block.clear();
+        }
+    }
+    writer.write(block);
+    return true;
+}
+
+auto kawe::binary::convert_log_to_json(
+    const std::filesystem::path &log,
+    const std::filesystem::path &json,
+    const std::function<void(std::size_t, std::size_t)> &on_progress) -> bool
+{
+    EventLogReader reader{log};
+    if (!reader.is_open()) { return false; }
+
+    std::ofstream ofs{json};
+    if (!ofs.is_open()) {
+        spdlog::error("convert_log_to_json: failed to open file: {}", json.string());
+        return false;
+    }
+
+    // note : the events are serialized one by one, the whole log is never held as json
+    ofs << "[";
+    std::size_t written = 0;
+    for (auto event = reader.next(); event.has_value(); event = reader.next()) {
+        nlohmann::json as_json;
+        event::to_json(as_json, *event);
+        if (written != 0) { ofs << ","; }
+        ofs << as_json;
+
+        if (++written % CONVERTER_BLOCK_SIZE == 0 && on_progress) { on_progress(written, reader.size()); }
+    }
+    ofs << "]";
+
+    if (on_progress) { on_progress(written, reader.size()); }
+    return true;
+}
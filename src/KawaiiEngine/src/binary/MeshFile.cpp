@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <glm/common.hpp>
+
+#include "binary/MeshFile.hpp"
+#include "helpers/BinaryFile.hpp"
+#include "helpers/Hash.hpp"
+
+namespace {
+
+using namespace kawe;
+using binary::MeshFormat;
+
+auto align(std::size_t offset) noexcept -> std::size_t
+{
+    return (offset + MeshFormat::ALIGNMENT - 1) / MeshFormat::ALIGNMENT * MeshFormat::ALIGNMENT;
+}
+
+/// offsets of the streams and size of the file
+struct Layout {
+    std::size_t positions;
+    std::size_t normals;
+    std::size_t texcoords;
+    std::size_t indices;
+    std::size_t end;
+};
+
+auto layout_of(std::uint64_t vertices, std::uint64_t indices) noexcept -> Layout
+{
+    Layout layout{};
+    layout.positions = MeshFormat::HEADER_SIZE;
+    layout.normals = align(layout.positions + vertices * 3 * sizeof(float));
+    layout.texcoords = align(layout.normals + vertices * 3 * sizeof(float));
+    layout.indices = align(layout.texcoords + vertices * 2 * sizeof(float));
+    layout.end = layout.indices + indices * sizeof(std::uint32_t);
+    return layout;
+}
+
+auto mtime_of(const std::filesystem::path &source, std::error_code &ec) -> std::int64_t
+{
+    const std::int64_t ticks = std::filesystem::last_write_time(source, ec).time_since_epoch().count();
+    return ticks;
+}
+
+} // namespace
+
+auto kawe::binary::MeshFile::describe(const std::filesystem::path &source) -> std::optional<Source>
+{
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(source, ec)) { return {}; }
+
+    const auto mtime = mtime_of(source, ec);
+    if (ec) { return {}; }
+
+    const MappedFile file{source};
+    if (!file.is_open()) { return {}; }
+    return Source{file.size(), mtime, fnv1a(file.bytes())};
+}
+
+auto kawe::binary::MeshFile::path_of(const std::filesystem::path &directory, const std::filesystem::path &source)
+    -> std::filesystem::path
+{
+    const auto name = source.generic_string();
+    const auto hash = fnv1a({reinterpret_cast<const std::uint8_t *>(name.data()), name.size()});
+    return directory / fmt::format("{:016x}{}", hash, MeshFormat::EXTENSION);
+}
+
+auto kawe::binary::MeshFile::open(const std::filesystem::path &path, const std::filesystem::path &source)
+    -> std::optional<MeshFile>
+{
+    if (std::error_code ec; !std::filesystem::is_regular_file(path, ec)) { return {}; }
+
+    MeshFile mesh;
+    mesh.m_file = MappedFile{path};
+    if (!mesh.m_file.is_open() || !mesh.parse(mesh.m_file.bytes())) {
+        spdlog::warn("MeshFile: '{}' is not a valid cooked mesh, it will be cooked again", path.string());
+        return {};
+    }
+
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(source, ec);
+    if (!ec && size == mesh.m_source.size && mtime_of(source, ec) == mesh.m_source.mtime && !ec) {
+        return mesh;
+    }
+
+    // note : only touched maybe, e.g. by a checkout, the content decides
+    if (const auto described = describe(source); described && described->hash == mesh.m_source.hash) { return mesh; }
+    return {};
+}
+
+auto kawe::binary::MeshFile::cook(const Streams &streams, const Source &source) -> std::vector<std::uint8_t>
+{
+    const auto vertices = streams.positions.size() / 3;
+    const auto layout = layout_of(vertices, streams.indices.size());
+
+    auto min = glm::vec3{std::numeric_limits<float>::max()};
+    auto max = glm::vec3{std::numeric_limits<float>::lowest()};
+    for (std::size_t i = 0; i != vertices; i++) {
+        const auto *position = &streams.positions[i * 3];
+        min = glm::min(min, glm::vec3{position[0], position[1], position[2]});
+        max = glm::max(max, glm::vec3{position[0], position[1], position[2]});
+    }
+    if (vertices == 0) { min = max = glm::vec3{0.0f}; }
+
+    std::vector<std::uint8_t> out(layout.end);
+    std::ranges::copy(MeshFormat::MAGIC, out.begin());
+    BinaryFile::put(out, 8, MeshFormat::VERSION, 2);
+    BinaryFile::put(out, 16, source.size, 8);
+    BinaryFile::put(out, 24, static_cast<std::uint64_t>(source.mtime), 8);
+    BinaryFile::put(out, 32, source.hash, 8);
+    for (glm::length_t i = 0; i != 3; i++) {
+        BinaryFile::put(out, 40 + static_cast<std::size_t>(i) * 4, std::bit_cast<std::uint32_t>(min[i]), 4);
+        BinaryFile::put(out, 52 + static_cast<std::size_t>(i) * 4, std::bit_cast<std::uint32_t>(max[i]), 4);
+    }
+    BinaryFile::put(out, 64, vertices, 8);
+    BinaryFile::put(out, 72, streams.indices.size(), 8);
+
+    // note : the streams are written as they are in memory, they are mapped back as is
+    const auto write = [&out](std::size_t offset, auto stream) {
+        if (!stream.empty()) { std::memcpy(&out[offset], stream.data(), stream.size_bytes()); }
+    };
+    write(layout.positions, streams.positions.first(vertices * 3));
+    write(layout.normals, streams.normals.first(vertices * 3));
+    write(layout.texcoords, streams.texcoords.first(vertices * 2));
+    write(layout.indices, streams.indices);
+    return out;
+}
+
+auto kawe::binary::MeshFile::from_memory(std::vector<std::uint8_t> bytes) -> std::optional<MeshFile>
+{
+    MeshFile mesh;
+    mesh.m_memory = std::move(bytes);
+    if (!mesh.parse(mesh.m_memory)) { return {}; }
+    return mesh;
+}
+
+auto kawe::binary::MeshFile::save(const std::filesystem::path &path, std::span<const std::uint8_t> bytes) -> bool
+{
+    return BinaryFile::save(path, bytes);
+}
+
+auto kawe::binary::MeshFile::parse(std::span<const std::uint8_t> bytes) -> bool
+{
+    if (bytes.size() < MeshFormat::HEADER_SIZE) { return false; }
+    if (!std::equal(MeshFormat::MAGIC.begin(), MeshFormat::MAGIC.end(), bytes.begin())) { return false; }
+    if (BinaryFile::get(bytes, 8, 2) != MeshFormat::VERSION) { return false; }
+
+    const auto vertices = BinaryFile::get(bytes, 64, 8);
+    const auto indices = BinaryFile::get(bytes, 72, 8);
+    // note : more than the file could hold, and the layout would overflow
+    if (vertices > bytes.size() || indices > bytes.size()) { return false; }
+
+    const auto layout = layout_of(vertices, indices);
+    if (layout.end > bytes.size()) { return false; }
+
+    m_source = {
+        BinaryFile::get(bytes, 16, 8),
+        static_cast<std::int64_t>(BinaryFile::get(bytes, 24, 8)),
+        BinaryFile::get(bytes, 32, 8)};
+    const auto get_float = [&bytes](std::size_t offset) {
+        return std::bit_cast<float>(static_cast<std::uint32_t>(BinaryFile::get(bytes, offset, 4)));
+    };
+    for (glm::length_t i = 0; i != 3; i++) {
+        m_min[i] = get_float(40 + static_cast<std::size_t>(i) * 4);
+        m_max[i] = get_float(52 + static_cast<std::size_t>(i) * 4);
+    }
+
+    // note : the offsets are aligned and the mapping starts on a page, the streams can be read in place
+    const auto floats = [&bytes](std::size_t offset, std::size_t count) {
+        return std::span<const float>{reinterpret_cast<const float *>(bytes.data() + offset), count};
+    };
+    m_positions = floats(layout.positions, vertices * 3);
+    m_normals = floats(layout.normals, vertices * 3);
+    m_texcoords = floats(layout.texcoords, vertices * 2);
+    m_indices = {reinterpret_cast<const std::uint32_t *>(bytes.data() + layout.indices), indices};
+
+    const auto out_of_range = std::ranges::any_of(m_indices, [vertices](auto index) { return index >= vertices; });
+    return !out_of_range;
+}
@@ -0,0 +1,292 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "binary/TextureFile.hpp"
+#include "helpers/BinaryFile.hpp"
+#include "helpers/Hash.hpp"
+#include "resources/Texture.hpp"
+
+namespace {
+
+using namespace kawe;
+using binary::TextureFormat;
+using Format = TextureFormat::Format;
+
+auto mip_count(std::uint32_t width, std::uint32_t height) noexcept -> std::uint32_t
+{
+    return std::bit_width(std::max(width, height));
+}
+
+/// box filter of the previous level, the last row / column is repeated for the odd sizes
+auto downsample(std::span<const std::uint8_t> src, std::uint32_t width, std::uint32_t height)
+    -> std::vector<std::uint8_t>
+{
+    const auto next_width = std::max(1u, width / 2);
+    const auto next_height = std::max(1u, height / 2);
+    std::vector<std::uint8_t> dst(std::size_t{next_width} * next_height * 4);
+
+    for (std::uint32_t y = 0; y != next_height; y++) {
+        const auto y0 = std::min(y * 2, height - 1);
+        const auto y1 = std::min(y * 2 + 1, height - 1);
+        for (std::uint32_t x = 0; x != next_width; x++) {
+            const auto x0 = std::min(x * 2, width - 1);
+            const auto x1 = std::min(x * 2 + 1, width - 1);
+            for (std::uint32_t c = 0; c != 4; c++) {
+                const auto at = [&](std::uint32_t px, std::uint32_t py) {
+                    return std::uint32_t{src[(std::size_t{py} * width + px) * 4 + c]};
+                };
+                const auto sum = at(x0, y0) + at(x1, y0) + at(x0, y1) + at(x1, y1);
+                dst[(std::size_t{y} * next_width + x) * 4 + c] = static_cast<std::uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+    return dst;
+}
+
+auto to_565(std::uint32_t r, std::uint32_t g, std::uint32_t b) noexcept -> std::uint16_t
+{
+    const auto r5 = (r * 31 + 127) / 255;
+    const auto g6 = (g * 63 + 127) / 255;
+    const auto b5 = (b * 31 + 127) / 255;
+    return static_cast<std::uint16_t>(r5 << 11 | g6 << 5 | b5);
+}
+
+auto from_565(std::uint16_t color) noexcept -> std::array<std::uint32_t, 3>
+{
+    const auto r = (color >> 11) & 31u;
+    const auto g = (color >> 5) & 63u;
+    const auto b = color & 31u;
+    return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+/// one 4x4 block: the alpha as BC4 then the color as BC1, the endpoints are the bounds of the block
+auto encode_bc3_block(const std::array<std::array<std::uint8_t, 4>, 16> &pixels, std::uint8_t *out) noexcept -> void
+{
+    // alpha, 8 interpolated values between a0 > a1
+    std::uint32_t a_min = 255;
+    std::uint32_t a_max = 0;
+    for (const auto &p : pixels) {
+        a_min = std::min<std::uint32_t>(a_min, p[3]);
+        a_max = std::max<std::uint32_t>(a_max, p[3]);
+    }
+    std::array<std::uint32_t, 8> alphas{a_max, a_min};
+    for (std::uint32_t i = 1; i != 7; i++) { alphas[i + 1] = ((7 - i) * a_max + i * a_min + 3) / 7; }
+
+    std::uint64_t alpha_bits = 0;
+    for (std::size_t i = 0; i != 16; i++) {
+        std::uint64_t best = 0;
+        for (std::uint64_t j = 1; j != 8; j++) {
+            const auto distance = [&](std::uint64_t k) {
+                return alphas[k] > pixels[i][3] ? alphas[k] - pixels[i][3] : pixels[i][3] - alphas[k];
+            };
+            if (distance(j) < distance(best)) { best = j; }
+        }
+        alpha_bits |= best << (3 * i);
+    }
+    out[0] = static_cast<std::uint8_t>(a_max);
+    out[1] = static_cast<std::uint8_t>(a_min);
+    for (std::size_t i = 0; i != 6; i++) { out[2 + i] = static_cast<std::uint8_t>(alpha_bits >> (8 * i)); }
+
+    // color, 4 values along the diagonal of the bounding box, slightly inset to lower the error
+    std::array<std::uint32_t, 3> low{255, 255, 255};
+    std::array<std::uint32_t, 3> high{0, 0, 0};
+    for (const auto &p : pixels) {
+        for (std::size_t c = 0; c != 3; c++) {
+            low[c] = std::min<std::uint32_t>(low[c], p[c]);
+            high[c] = std::max<std::uint32_t>(high[c], p[c]);
+        }
+    }
+    for (std::size_t c = 0; c != 3; c++) {
+        const auto inset = (high[c] - low[c]) / 16;
+        low[c] += inset;
+        high[c] -= inset;
+    }
+
+    auto c0 = to_565(high[0], high[1], high[2]);
+    auto c1 = to_565(low[0], low[1], low[2]);
+    // note : c0 > c1 selects the 4 colors mode, with c0 == c1 every index picks c0
+    if (c0 < c1) { std::swap(c0, c1); }
+
+    const auto e0 = from_565(c0);
+    const auto e1 = from_565(c1);
+    std::array<std::array<std::uint32_t, 3>, 4> colors{e0, e1};
+    for (std::size_t c = 0; c != 3; c++) {
+        colors[2][c] = (2 * e0[c] + e1[c] + 1) / 3;
+        colors[3][c] = (e0[c] + 2 * e1[c] + 1) / 3;
+    }
+
+    std::uint32_t color_bits = 0;
+    for (std::size_t i = 0; i != 16; i++) {
+        std::uint32_t best = 0;
+        auto best_distance = std::numeric_limits<std::uint32_t>::max();
+        for (std::uint32_t j = 0; j != (c0 == c1 ? 1u : 4u); j++) {
+            std::uint32_t distance = 0;
+            for (std::size_t c = 0; c != 3; c++) {
+                const auto d = static_cast<std::int32_t>(colors[j][c]) - pixels[i][c];
+                distance += static_cast<std::uint32_t>(d * d);
+            }
+            if (distance < best_distance) {
+                best = j;
+                best_distance = distance;
+            }
+        }
+        color_bits |= best << (2 * i);
+    }
+    out[8] = static_cast<std::uint8_t>(c0);
+    out[9] = static_cast<std::uint8_t>(c0 >> 8);
+    out[10] = static_cast<std::uint8_t>(c1);
+    out[11] = static_cast<std::uint8_t>(c1 >> 8);
+    for (std::size_t i = 0; i != 4; i++) { out[12 + i] = static_cast<std::uint8_t>(color_bits >> (8 * i)); }
+}
+
+auto encode_bc3(std::span<const std::uint8_t> src, std::uint32_t width, std::uint32_t height, std::uint8_t *out)
+    -> void
+{
+    std::array<std::array<std::uint8_t, 4>, 16> pixels{};
+    for (std::uint32_t by = 0; by < height; by += 4) {
+        for (std::uint32_t bx = 0; bx < width; bx += 4) {
+            // note : the blocks overflowing the image repeat its last row / column
+            for (std::uint32_t i = 0; i != 16; i++) {
+                const auto x = std::min(bx + i % 4, width - 1);
+                const auto y = std::min(by + i / 4, height - 1);
+                std::memcpy(pixels[i].data(), &src[(std::size_t{y} * width + x) * 4], 4);
+            }
+            encode_bc3_block(pixels, out);
+            out += 16;
+        }
+    }
+}
+
+} // namespace
+
+auto kawe::binary::TextureFile::hash_source(const std::filesystem::path &source) -> std::optional<std::uint64_t>
+{
+    if (std::error_code ec; !std::filesystem::is_regular_file(source, ec)) { return {}; }
+
+    const MappedFile file{source};
+    if (!file.is_open()) { return {}; }
+    return fnv1a(file.bytes());
+}
+
+auto kawe::binary::TextureFile::path_of(
+    const std::filesystem::path &directory, std::uint64_t source_hash, Format format) -> std::filesystem::path
+{
+    return directory / fmt::format("{:016x}.{}{}", source_hash, static_cast<int>(format), TextureFormat::EXTENSION);
+}
+
+auto kawe::binary::TextureFile::open(const std::filesystem::path &path, std::uint64_t source_hash, Format format)
+    -> std::optional<TextureFile>
+{
+    if (std::error_code ec; !std::filesystem::is_regular_file(path, ec)) { return {}; }
+
+    TextureFile texture;
+    texture.m_file = MappedFile{path};
+    if (!texture.m_file.is_open() || !texture.parse(texture.m_file.bytes(), source_hash, format)) {
+        spdlog::warn("TextureFile: '{}' is not a valid cooked texture, it will be cooked again", path.string());
+        return {};
+    }
+    return texture;
+}
+
+auto kawe::binary::TextureFile::from_memory(std::vector<std::uint8_t> bytes, std::uint64_t source_hash, Format format)
+    -> std::optional<TextureFile>
+{
+    TextureFile texture;
+    texture.m_memory = std::move(bytes);
+    if (!texture.parse(texture.m_memory, source_hash, format)) { return {}; }
+    return texture;
+}
+
+auto kawe::binary::TextureFile::cook(const Texture &image, std::uint64_t source_hash, Format format)
+    -> std::vector<std::uint8_t>
+{
+    const auto width = static_cast<std::uint32_t>(image.width);
+    const auto height = static_cast<std::uint32_t>(image.height);
+    const auto levels = mip_count(width, height);
+
+    const auto align = [](std::size_t offset) {
+        return (offset + TextureFormat::ALIGNMENT - 1) / TextureFormat::ALIGNMENT * TextureFormat::ALIGNMENT;
+    };
+
+    // note : the layout is computed first so the data is written in place
+    std::vector<std::size_t> offsets(levels);
+    auto end = align(TextureFormat::HEADER_SIZE + levels * TextureFormat::LEVEL_SIZE);
+    for (std::uint32_t level = 0; level != levels; level++) {
+        offsets[level] = end;
+        const auto level_width = std::max(1u, width >> level);
+        const auto level_height = std::max(1u, height >> level);
+        end = align(end + TextureFormat::level_size(format, level_width, level_height));
+    }
+
+    std::vector<std::uint8_t> out(end);
+    std::ranges::copy(TextureFormat::MAGIC, out.begin());
+    BinaryFile::put(out, 8, TextureFormat::VERSION, 2);
+    BinaryFile::put(out, 10, static_cast<std::uint16_t>(format), 2);
+    BinaryFile::put(out, 12, width, 4);
+    BinaryFile::put(out, 16, height, 4);
+    BinaryFile::put(out, 20, levels, 4);
+    BinaryFile::put(out, 24, source_hash, 8);
+
+    std::vector<std::uint8_t> current(image.data, image.data + std::size_t{width} * height * 4);
+    for (std::uint32_t level = 0; level != levels; level++) {
+        const auto level_width = std::max(1u, width >> level);
+        const auto level_height = std::max(1u, height >> level);
+        const auto size = TextureFormat::level_size(format, level_width, level_height);
+
+        const auto entry = TextureFormat::HEADER_SIZE + level * TextureFormat::LEVEL_SIZE;
+        BinaryFile::put(out, entry, offsets[level], 8);
+        BinaryFile::put(out, entry + 8, size, 8);
+
+        if (format == Format::BC3) {
+            encode_bc3(current, level_width, level_height, &out[offsets[level]]);
+        } else {
+            std::ranges::copy(current, out.begin() + static_cast<std::ptrdiff_t>(offsets[level]));
+        }
+
+        if (level + 1 != levels) { current = downsample(current, level_width, level_height); }
+    }
+
+    return out;
+}
+
+auto kawe::binary::TextureFile::save(const std::filesystem::path &path, std::span<const std::uint8_t> bytes) -> bool
+{
+    return BinaryFile::save(path, bytes);
+}
+
+auto kawe::binary::TextureFile::parse(std::span<const std::uint8_t> bytes, std::uint64_t source_hash, Format format)
+    -> bool
+{
+    if (bytes.size() < TextureFormat::HEADER_SIZE) { return false; }
+    if (!std::equal(TextureFormat::MAGIC.begin(), TextureFormat::MAGIC.end(), bytes.begin())) { return false; }
+    if (BinaryFile::get(bytes, 8, 2) != TextureFormat::VERSION) { return false; }
+    if (BinaryFile::get(bytes, 10, 2) != static_cast<std::uint16_t>(format)) { return false; }
+    if (BinaryFile::get(bytes, 24, 8) != source_hash) { return false; }
+
+    const auto width = static_cast<std::uint32_t>(BinaryFile::get(bytes, 12, 4));
+    const auto height = static_cast<std::uint32_t>(BinaryFile::get(bytes, 16, 4));
+    const auto levels = static_cast<std::uint32_t>(BinaryFile::get(bytes, 20, 4));
+    if (width == 0 || height == 0 || levels != mip_count(width, height)) { return false; }
+    if (bytes.size() < TextureFormat::HEADER_SIZE + std::size_t{levels} * TextureFormat::LEVEL_SIZE) { return false; }
+
+    m_levels.clear();
+    for (std::uint32_t level = 0; level != levels; level++) {
+        const auto entry = TextureFormat::HEADER_SIZE + level * TextureFormat::LEVEL_SIZE;
+        const auto offset = BinaryFile::get(bytes, entry, 8);
+        const auto size = BinaryFile::get(bytes, entry + 8, 8);
+        const auto level_width = std::max(1u, width >> level);
+        const auto level_height = std::max(1u, height >> level);
+
+        if (size != TextureFormat::level_size(format, level_width, level_height)) { return false; }
+        if (offset > bytes.size() || size > bytes.size() - offset) { return false; }
+
+        m_levels.push_back({level_width, level_height, bytes.subspan(offset, size)});
+    }
+
+    m_format = format;
+    return true;
+}
@@ -0,0 +1,73 @@
+#include <spdlog/spdlog.h>
+
+#include "graphics/GLLayer.hpp"
+
+auto kawe::GLLayer::init() -> void
+{
+    ::glDebugMessageCallback(
+        []([[maybe_unused]] GLenum source,
+           GLenum type,
+           [[maybe_unused]] GLuint id,
+           [[maybe_unused]] GLenum severity,
+           [[maybe_unused]] GLsizei length,
+           const GLchar *message,
+           const void *) {
+            if (type == GL_DEBUG_TYPE_ERROR) {
+                GLLayer::get().m_callback_errors++;
+                spdlog::get("console")->error("[Engine] GL CALLBACK: message = {}", message);
+            } else {
+                spdlog::get("console")->warn("[Engine] GL CALLBACK: message = {}", message);
+            }
+        },
+        nullptr);
+
+    applyErrorCheck();
+}
+
+auto kawe::GLLayer::setErrorCheck(ErrorCheck mode) -> void
+{
+    m_mode = mode;
+    applyErrorCheck();
+}
+
+auto kawe::GLLayer::applyErrorCheck() -> void
+{
+    // note : the debug output is asynchronous, it stays on in every mode checking the errors
+    if (m_mode == ErrorCheck::OFF) {
+        ::glDisable(GL_DEBUG_OUTPUT);
+    } else {
+        ::glEnable(GL_DEBUG_OUTPUT);
+    }
+}
+
+auto kawe::GLLayer::end_frame() noexcept -> void
+{
+    if (m_mode == ErrorCheck::PER_FRAME) { check("frame", __FILE__, __LINE__); }
+
+    m_current.calls += m_background.calls.exchange(0);
+    m_current.state_changes += m_background.state_changes.exchange(0);
+    m_current.uploads += m_background.uploads.exchange(0);
+    m_current.upload_bytes += m_background.upload_bytes.exchange(0);
+    m_current.errors += m_background.errors.exchange(0);
+    m_current.callback_errors += m_callback_errors.exchange(0);
+    m_last = m_current;
+    m_current = {};
+}
+
+auto kawe::GLLayer::end_background_batch() noexcept -> void
+{
+    if (m_mode == ErrorCheck::PER_FRAME) { check("upload batch", __FILE__, __LINE__); }
+}
+
+auto kawe::GLLayer::check(const char *call, const char *file, int line) noexcept -> void
+{
+    // note : an error flag is kept per kind of error, drain all of them
+    for (auto err = ::glGetError(); err != GL_NO_ERROR; err = ::glGetError()) {
+        if (t_background) {
+            m_background.errors++;
+        } else {
+            m_current.errors++;
+        }
+        spdlog::error("CALL_OPEN_GL: {} after {} at {}: {}", GetGLErrorStr(err), call, file, line);
+    }
+}
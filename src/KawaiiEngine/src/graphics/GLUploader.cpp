@@ -0,0 +1,138 @@
+#include <spdlog/spdlog.h>
+
+#include "graphics/GLUploader.hpp"
+#include "helpers/macro.hpp"
+#include "Profiler.hpp"
+
+namespace {
+
+// note : a fence per batch of jobs, so a job is published at most this many jobs after it has been run
+constexpr std::size_t MAX_BATCH_SIZE = 8;
+
+} // namespace
+
+auto kawe::GLUploader::start(GLFWwindow *shared) -> bool
+{
+    // note : the other hints are still the ones of the render context, so both contexts are alike
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    m_window = glfwCreateWindow(1, 1, "kawe upload", nullptr, shared);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+
+    if (m_window == nullptr) {
+        spdlog::get("console")->warn("[GLUploader] no upload context, the uploads are run on the render thread");
+        return false;
+    }
+
+    m_thread = std::thread{[this] { run(); }};
+    return true;
+}
+
+auto kawe::GLUploader::stop() -> void
+{
+    if (!m_thread.joinable()) { return; }
+
+    {
+        std::lock_guard lock{m_mutex};
+        m_stop = true;
+        m_tasks.clear();
+    }
+    m_wake.notify_all();
+    m_thread.join();
+
+    for (auto &batch : m_batches) { CALL_OPEN_GL(::glDeleteSync(batch.fence)); }
+    m_batches.clear();
+    m_pending = 0;
+
+    glfwDestroyWindow(m_window);
+    m_window = nullptr;
+}
+
+auto kawe::GLUploader::submit(Job job, Done done) -> void
+{
+    if (!isThreaded()) {
+        job();
+        done();
+        return;
+    }
+
+    m_pending++;
+    {
+        std::lock_guard lock{m_mutex};
+        m_tasks.push_back({std::move(job), std::move(done)});
+    }
+    m_wake.notify_one();
+}
+
+auto kawe::GLUploader::applyErrorCheck() -> void
+{
+    // note : without an upload context, the render context is the only one and already up to date
+    if (!isThreaded()) { return; }
+    submit([] { GLLayer::get().applyErrorCheck(); }, [] {});
+}
+
+auto kawe::GLUploader::update() -> void
+{
+    std::vector<Done> published;
+    {
+        std::lock_guard lock{m_mutex};
+        while (!m_batches.empty()) {
+            auto &batch = m_batches.front();
+            GLenum status = GL_WAIT_FAILED;
+            CALL_OPEN_GL(status = ::glClientWaitSync(batch.fence, 0, 0));
+            if (status == GL_TIMEOUT_EXPIRED) { break; }
+
+            CALL_OPEN_GL(::glDeleteSync(batch.fence));
+            for (auto &done : batch.done) { published.push_back(std::move(done)); }
+            m_batches.pop_front();
+        }
+    }
+
+    m_pending -= published.size();
+    for (const auto &done : published) { done(); }
+}
+
+auto kawe::GLUploader::run() -> void
+{
+    glfwMakeContextCurrent(m_window);
+    Profiler::get().setThreadName("gl upload");
+    GLLayer::setBackgroundThread();
+    // note : the debug output callback is per context
+    GLLayer::get().init();
+
+    Batch batch;
+    while (true) {
+        Task task;
+        {
+            std::unique_lock lock{m_mutex};
+            m_wake.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+            if (m_stop) { break; }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        {
+            KAWE_PROFILE_ZONE("upload job");
+            task.job();
+        }
+        batch.done.push_back(std::move(task.done));
+
+        bool idle = false;
+        {
+            std::lock_guard lock{m_mutex};
+            idle = m_tasks.empty();
+        }
+        if (!idle && batch.done.size() != MAX_BATCH_SIZE) { continue; }
+
+        GLLayer::get().end_background_batch();
+        CALL_OPEN_GL(batch.fence = ::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        // note : the fence is only signaled once it has reached the GPU, nothing else flushes this context
+        CALL_OPEN_GL(::glFlush());
+        {
+            std::lock_guard lock{m_mutex};
+            m_batches.push_back(std::move(batch));
+        }
+        batch = Batch{};
+    }
+
+    glfwMakeContextCurrent(nullptr);
+}
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "graphics/GpuBufferCache.hpp"
+
+kawe::GpuBufferCache::~GpuBufferCache()
+{
+    // note : every component holding a buffer is destroyed before, anything left has been leaked by its user
+    if (!m_buffers.empty()) { spdlog::warn("[GpuBufferCache] {} buffers still referenced", m_buffers.size()); }
+}
+
+auto kawe::GpuBufferCache::acquire(const Key &key, const void *data, std::shared_ptr<const void> storage) -> GLuint
+{
+    if (const auto found = find(key, data); found.has_value()) {
+        m_buffers.at(*found).refs++;
+        m_shared++;
+        CALL_OPEN_GL(::glBindBuffer(key.target, *found));
+        return *found;
+    }
+
+    // note : created here so it can be attached to a vertex array at once, only its content is uploaded later
+    GLuint object = 0;
+    CALL_OPEN_GL(::glCreateBuffers(1, &object));
+    CALL_OPEN_GL(::glBindBuffer(key.target, object));
+
+    // note : the caller's content may be gone by the time the job runs, it is staged in a copy, which is also the
+    //        one compared to the next contents having the same hash
+    if (storage == nullptr) {
+        auto staging = std::make_shared<std::vector<std::uint8_t>>(key.bytes);
+        if (key.bytes != 0) { std::memcpy(staging->data(), data, key.bytes); }
+        data = staging->data();
+        storage = std::move(staging);
+    }
+
+    m_objects.emplace(key, object);
+    m_buffers.emplace(object, Buffer{key, data, storage, 1, false});
+    m_bytes += key.bytes;
+    m_pending++;
+
+    m_uploader.submit(
+        [object, data, bytes = key.bytes, storage = std::move(storage)] {
+            CALL_OPEN_GL_UPLOAD(
+                ::glNamedBufferData(object, static_cast<GLsizeiptr>(bytes), data, GL_STATIC_DRAW), bytes);
+        },
+        [this, object] { on_uploaded(object); });
+    return object;
+}
+
+auto kawe::GpuBufferCache::find(const Key &key, const void *data) const -> std::optional<GLuint>
+{
+    const auto [first, last] = m_objects.equal_range(key);
+    for (auto it = first; it != last; ++it) {
+        // note : a content in a storage is told apart by its key alone
+        if (key.storage != nullptr || key.bytes == 0
+            || std::memcmp(m_buffers.at(it->second).data, data, key.bytes) == 0) {
+            return it->second;
+        }
+    }
+    return {};
+}
+
+auto kawe::GpuBufferCache::release(GLuint buffer) -> void
+{
+    const auto found = m_buffers.find(buffer);
+    if (found == m_buffers.end() || found->second.refs == 0) {
+        spdlog::warn("[GpuBufferCache] release of unknown buffer {}", buffer);
+        return;
+    }
+
+    if (--found->second.refs != 0) { return; }
+
+    m_bytes -= found->second.key.bytes;
+    const auto [first, last] = m_objects.equal_range(found->second.key);
+    m_objects.erase(std::find_if(first, last, [buffer](const auto &object) { return object.second == buffer; }));
+
+    // note : the upload thread still writes to it, it is deleted once the upload is done
+    if (!found->second.ready) { return; }
+
+    m_buffers.erase(found);
+    CALL_OPEN_GL(::glDeleteBuffers(1, &buffer));
+}
+
+auto kawe::GpuBufferCache::on_uploaded(GLuint buffer) -> void
+{
+    m_pending--;
+
+    const auto found = m_buffers.find(buffer);
+    if (found->second.refs != 0) {
+        found->second.ready = true;
+        return;
+    }
+
+    m_buffers.erase(found);
+    CALL_OPEN_GL(::glDeleteBuffers(1, &buffer));
+}
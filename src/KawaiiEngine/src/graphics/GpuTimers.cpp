@@ -0,0 +1,49 @@
+#include "graphics/GpuTimers.hpp"
+
+kawe::GpuTimers::GpuTimers(FrameStats &stats) : m_stats{stats}
+{
+    for (auto &slot : m_slots) {
+        CALL_OPEN_GL(::glGenQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data()));
+    }
+}
+
+kawe::GpuTimers::~GpuTimers()
+{
+    for (auto &slot : m_slots) {
+        CALL_OPEN_GL(::glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data()));
+    }
+}
+
+auto kawe::GpuTimers::measure(Pass pass) -> Scope
+{
+    const auto index = static_cast<std::size_t>(pass);
+    auto &slot = m_slots[m_current];
+    slot.issued[index] = true;
+    return Scope{slot.queries[index]};
+}
+
+auto kawe::GpuTimers::end_frame() -> void
+{
+    m_current = (m_current + 1) % LATENCY;
+
+    // note : the next slot to be written is the oldest one, issued `LATENCY - 1` frames ago
+    auto &oldest = m_slots[m_current];
+    for (std::size_t pass = 0; pass != PASS_COUNT; pass++) {
+        if (!oldest.issued[pass]) { continue; }
+        oldest.issued[pass] = false;
+
+        GLint available = GL_FALSE;
+        CALL_OPEN_GL(::glGetQueryObjectiv(oldest.queries[pass], GL_QUERY_RESULT_AVAILABLE, &available));
+        if (available == GL_FALSE) {
+            m_late++;
+            continue;
+        }
+
+        GLuint64 elapsed = 0;
+        CALL_OPEN_GL(::glGetQueryObjectui64v(oldest.queries[pass], GL_QUERY_RESULT, &elapsed));
+
+        const auto time = std::chrono::nanoseconds{static_cast<std::chrono::nanoseconds::rep>(elapsed)};
+        m_last[pass] = time;
+        m_stats.add(SECTION_NAMES[pass], time);
+    }
+}
@@ -0,0 +1,432 @@
+#include <algorithm>
+
+#include "resources/ResourceLoader.hpp"
+#include "graphics/TextureCache.hpp"
+
+kawe::TextureCache::~TextureCache()
+{
+    // note : every component holding a texture is destroyed before, anything left has been leaked by its user
+    if (!m_paths.empty()) { spdlog::warn("[TextureCache] {} textures still referenced", m_paths.size()); }
+}
+
+auto kawe::TextureCache::acquire(const std::string &filepath) -> Handle
+{
+    if (const auto found = m_paths.find(filepath); found != m_paths.end()) {
+        m_images[found->second].refs++;
+        m_shared++;
+        return found->second;
+    }
+
+    Handle handle = 0;
+    if (!m_free_images.empty()) {
+        handle = m_free_images.back();
+        m_free_images.pop_back();
+    } else {
+        handle = static_cast<Handle>(m_images.size());
+        m_images.emplace_back();
+    }
+
+    auto &image = m_images[handle];
+    image.filepath = filepath;
+    image.refs = 1;
+    image.state = Image::State::LOADING;
+    image.loading = m_workers.submit([this, filepath] { return cook(filepath); });
+    m_paths.emplace(filepath, handle);
+    m_pending.push_back(handle);
+    return handle;
+}
+
+auto kawe::TextureCache::release(Handle handle) -> void
+{
+    if (handle >= m_images.size() || m_images[handle].refs == 0) { return; }
+
+    auto &image = m_images[handle];
+    if (--image.refs != 0) { return; }
+
+    std::erase(m_pending, handle);
+    // note : a job still running finishes on its own, its result is dropped with the future
+    m_paths.erase(image.filepath);
+
+    if (const auto &committed = image.streaming ? image.streaming : image.resident; committed) {
+        m_resident_bytes -= bytes_from(image.cooked->getLevels(), committed->level);
+    }
+
+    if (image.uploading != 0) {
+        image.state = Image::State::DROPPED;
+        image.cooked.reset();
+        return;
+    }
+
+    if (image.resident) { free_layer(image.resident->location); }
+    if (image.streaming) { free_layer(image.streaming->location); }
+    image = Image{};
+    m_free_images.push_back(handle);
+}
+
+auto kawe::TextureCache::request(Handle handle, double pixels) -> void
+{
+    if (handle >= m_images.size() || m_images[handle].state != Image::State::LOADED) { return; }
+
+    auto &image = m_images[handle];
+    const auto levels = image.cooked->getLevels();
+
+    // note : the coarsest level still at least as large as the image on screen
+    std::size_t level = 0;
+    while (level + 1 < levels.size()
+           && static_cast<double>(std::max(levels[level + 1].width, levels[level + 1].height)) >= pixels) {
+        level++;
+    }
+
+    if (image.last_used != m_frame) {
+        image.wanted_level = level;
+        image.last_used = m_frame;
+    } else {
+        image.wanted_level = std::min(image.wanted_level, level);
+    }
+}
+
+auto kawe::TextureCache::update() -> void
+{
+    m_frame++;
+
+    for (const auto handle : m_pending) {
+        auto &image = m_images[handle];
+        if (image.state != Image::State::LOADING
+            || image.loading.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+            continue;
+        }
+
+        auto cooked = image.loading.get();
+        if (!cooked) {
+            image.state = Image::State::FAILED;
+            continue;
+        }
+        image.cooked = std::make_shared<const binary::TextureFile>(std::move(*cooked));
+        image.state = Image::State::LOADED;
+        // note : the coarse levels first, they are small enough to replace the placeholder at once
+        stream(handle, coarsest_level(image.cooked->getLevels()));
+    }
+
+    for (Handle handle = 0; handle != m_images.size(); handle++) {
+        const auto &image = m_images[handle];
+        if (image.state != Image::State::LOADED || image.streaming || !image.resident) { continue; }
+
+        const auto target = target_level(image);
+        if (target >= image.resident->level) { continue; }
+
+        const auto levels = image.cooked->getLevels();
+        if (!make_room(bytes_from(levels, target) - bytes_from(levels, image.resident->level), handle)) { continue; }
+        stream(handle, target);
+    }
+
+    std::size_t submitted = 0;
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        const auto handle = *it;
+        auto &image = m_images[handle];
+
+        if (image.state == Image::State::LOADING) {
+            ++it;
+            continue;
+        }
+        // note : failed to load, or streamed already, which is at once without an upload thread
+        if (!image.streaming) {
+            it = m_pending.erase(it);
+            continue;
+        }
+
+        const auto levels = image.cooked->getLevels().size();
+        while (submitted < m_upload_budget && image.next_level != levels) { submitted += upload_level(handle); }
+
+        if (image.next_level != levels) { break; }
+
+        if (image.streaming) {
+            ++it;
+        } else {
+            it = m_pending.erase(it);
+        }
+    }
+}
+
+auto kawe::TextureCache::getBinding(Handle handle) -> Binding
+{
+    if (handle < m_images.size() && m_images[handle].resident) {
+        const auto &location = m_images[handle].resident->location;
+        return {m_pools[location.pool].object, location.layer};
+    }
+
+    if (m_placeholder == 0) {
+        // note : a plain light grey, lit like any other texture
+        constexpr auto pixel = std::to_array<std::uint8_t>({192, 192, 192, 255});
+        CALL_OPEN_GL(::glGenTextures(1, &m_placeholder));
+        m_state.bindTexture(GL_TEXTURE_2D_ARRAY, m_placeholder);
+        CALL_OPEN_GL(::glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, 1, 1, 1));
+        CALL_OPEN_GL_UPLOAD(
+            ::glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, 1, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel.data()),
+            pixel.size());
+    }
+    return {m_placeholder, 0};
+}
+
+auto kawe::TextureCache::target_level(const Image &image) const noexcept -> std::size_t
+{
+    const auto coarsest = coarsest_level(image.cooked->getLevels());
+    if (image.last_used == Image::NEVER || image.last_used + 1 < m_frame) { return coarsest; }
+    return std::min(image.wanted_level, coarsest);
+}
+
+auto kawe::TextureCache::make_room(std::size_t bytes, Handle except) -> bool
+{
+    if (m_resident_bytes + bytes <= m_budget) { return true; }
+
+    std::vector<Handle> victims;
+    for (Handle handle = 0; handle != m_images.size(); handle++) {
+        const auto &image = m_images[handle];
+        if (handle == except || image.state != Image::State::LOADED || image.streaming || !image.resident) { continue; }
+        if (target_level(image) > image.resident->level) { victims.push_back(handle); }
+    }
+
+    // note : the images never drawn go first, then the least recently drawn ones
+    const auto age = [this](Handle handle) {
+        const auto last_used = m_images[handle].last_used;
+        return last_used == Image::NEVER ? 0 : last_used + 1;
+    };
+    std::sort(victims.begin(), victims.end(), [&age](Handle lhs, Handle rhs) { return age(lhs) < age(rhs); });
+
+    // note : nothing is evicted if it would not be enough anyway
+    std::size_t freed = 0;
+    std::size_t count = 0;
+    for (; count != victims.size() && m_resident_bytes - freed + bytes > m_budget; count++) {
+        const auto &image = m_images[victims[count]];
+        const auto levels = image.cooked->getLevels();
+        freed += bytes_from(levels, image.resident->level) - bytes_from(levels, target_level(image));
+    }
+    if (m_resident_bytes - freed + bytes > m_budget) { return false; }
+
+    for (std::size_t i = 0; i != count; i++) {
+        stream(victims[i], target_level(m_images[victims[i]]));
+        m_evicted++;
+    }
+    return true;
+}
+
+auto kawe::TextureCache::stream(Handle handle, std::size_t level) -> void
+{
+    auto &image = m_images[handle];
+    const auto levels = image.cooked->getLevels();
+
+    // note : the budget counts the new levels at once, the old ones are freed when they are replaced
+    m_resident_bytes += bytes_from(levels, level);
+    if (image.resident) { m_resident_bytes -= bytes_from(levels, image.resident->level); }
+
+    image.streaming = Resident{find_layer(image.cooked->getFormat(), levels.subspan(level)), level};
+    image.next_level = level;
+    if (std::find(m_pending.begin(), m_pending.end(), handle) == m_pending.end()) { m_pending.push_back(handle); }
+}
+
+auto kawe::TextureCache::upload_level(Handle handle) -> std::size_t
+{
+    auto &image = m_images[handle];
+    const auto level = image.next_level++;
+    const auto &mip = image.cooked->getLevels()[level];
+    const auto bytes = mip.data.size();
+    const auto location = image.streaming->location;
+    auto &pool = m_pools[location.pool];
+    pool.uploading++;
+    image.uploading++;
+
+    // note : read straight from the cooked file, the upload thread may block on the copy without stalling a frame
+    m_uploader.submit(
+        [cooked = image.cooked,
+         object = pool.object,
+         internal_format = pool.internal_format,
+         layer = static_cast<GLint>(location.layer),
+         level = static_cast<GLint>(level - image.streaming->level),
+         width = static_cast<GLsizei>(mip.width),
+         height = static_cast<GLsizei>(mip.height),
+         data = mip.data] {
+            if (cooked->getFormat() == binary::TextureFile::Format::RGBA8) {
+                CALL_OPEN_GL_UPLOAD(
+                    ::glTextureSubImage3D(
+                        object, level, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, data.data()),
+                    data.size());
+            } else {
+                CALL_OPEN_GL_UPLOAD(
+                    ::glCompressedTextureSubImage3D(
+                        object,
+                        level,
+                        0,
+                        0,
+                        layer,
+                        width,
+                        height,
+                        1,
+                        internal_format,
+                        static_cast<GLsizei>(data.size()),
+                        data.data()),
+                    data.size());
+            }
+        },
+        [this, handle, pool_index = location.pool] { on_uploaded(handle, pool_index); });
+
+    return bytes;
+}
+
+auto kawe::TextureCache::on_uploaded(Handle handle, std::uint32_t pool) -> void
+{
+    auto &image = m_images[handle];
+    m_pools[pool].uploading--;
+    image.uploading--;
+
+    if (image.state == Image::State::DROPPED) {
+        if (image.uploading != 0) { return; }
+        if (image.resident) { free_layer(image.resident->location); }
+        if (image.streaming) { free_layer(image.streaming->location); }
+        image = Image{};
+        m_free_images.push_back(handle);
+        return;
+    }
+
+    if (image.uploading != 0 || image.next_level != image.cooked->getLevels().size()) { return; }
+
+    if (image.resident) { free_layer(image.resident->location); }
+    image.resident = image.streaming;
+    image.streaming.reset();
+    // note : re-bound before its next draw, so the content written by the upload context is visible to this one
+    m_state.forgetTexture(m_pools[image.resident->location.pool].object);
+}
+
+auto kawe::TextureCache::free_layer(const Location &location) -> void
+{
+    auto &pool = m_pools[location.pool];
+    pool.free_layers.push_back(location.layer);
+    if (--pool.used != 0) { return; }
+
+    m_bytes -= pool.capacity * pool.layer_bytes;
+    m_pool_count--;
+    m_state.forgetTexture(pool.object);
+    CALL_OPEN_GL(::glDeleteTextures(1, &pool.object));
+    pool = Pool{};
+}
+
+auto kawe::TextureCache::cook(const std::string &filepath) const -> std::optional<binary::TextureFile>
+{
+    const auto hash = binary::TextureFile::hash_source(filepath);
+    if (!hash) {
+        spdlog::error("couldn't load texture at '{}'.", filepath);
+        return {};
+    }
+
+    const auto path = binary::TextureFile::path_of(DIRECTORY, *hash, m_format);
+    if (auto cooked = binary::TextureFile::open(path, *hash, m_format); cooked) { return cooked; }
+
+    // note : first use of this image, the next runs map the cooked file instead of decoding it
+    const auto image = m_loader.load<Texture>(filepath);
+    if (!image) { return {}; }
+
+    spdlog::info("[TextureCache] cooking '{}' to '{}'", filepath, path.string());
+    auto bytes = binary::TextureFile::cook(*image, *hash, m_format);
+    // note : mapped back once saved, the image is kept for streaming and the pages can be dropped by the system
+    if (binary::TextureFile::save(path, bytes)) {
+        if (auto cooked = binary::TextureFile::open(path, *hash, m_format); cooked) { return cooked; }
+    }
+    return binary::TextureFile::from_memory(std::move(bytes), *hash, m_format);
+}
+
+auto kawe::TextureCache::find_layer(
+    binary::TextureFile::Format format, std::span<const binary::TextureFile::Level> levels) -> Location
+{
+    const auto width = static_cast<GLsizei>(levels.front().width);
+    const auto height = static_cast<GLsizei>(levels.front().height);
+    const auto internal_format = binary::TextureFormat::internal_format(format);
+
+    auto empty = m_pools.size();
+    for (std::size_t i = 0; i != m_pools.size(); i++) {
+        auto &pool = m_pools[i];
+        if (pool.object == 0) {
+            empty = std::min(empty, i);
+            continue;
+        }
+        if (pool.width != width || pool.height != height || pool.internal_format != internal_format) { continue; }
+        if (pool.free_layers.empty() && pool.capacity != MAX_LAYERS && pool.uploading == 0) {
+            grow(pool, std::min(pool.capacity * 2, MAX_LAYERS));
+        }
+        if (pool.free_layers.empty()) { continue; }
+
+        const auto layer = pool.free_layers.back();
+        pool.free_layers.pop_back();
+        pool.used++;
+        return {static_cast<std::uint32_t>(i), layer};
+    }
+
+    if (empty == m_pools.size()) { m_pools.emplace_back(); }
+    auto &pool = m_pools[empty];
+    pool.width = width;
+    pool.height = height;
+    pool.levels = static_cast<GLsizei>(levels.size());
+    pool.internal_format = internal_format;
+    pool.layer_bytes = 0;
+    for (const auto &level : levels) { pool.layer_bytes += level.data.size(); }
+    grow(pool, INITIAL_LAYERS);
+    m_pool_count++;
+
+    const auto layer = pool.free_layers.back();
+    pool.free_layers.pop_back();
+    pool.used++;
+    return {static_cast<std::uint32_t>(empty), layer};
+}
+
+auto kawe::TextureCache::grow(Pool &pool, std::uint32_t capacity) -> void
+{
+    GLuint object = 0;
+    CALL_OPEN_GL(::glGenTextures(1, &object));
+    m_state.bindTexture(GL_TEXTURE_2D_ARRAY, object);
+    const auto layers = static_cast<GLsizei>(capacity);
+    CALL_OPEN_GL(
+        ::glTexStorage3D(GL_TEXTURE_2D_ARRAY, pool.levels, pool.internal_format, pool.width, pool.height, layers));
+
+    if (pool.object != 0) {
+        for (GLint level = 0; level != pool.levels; level++) {
+            CALL_OPEN_GL(::glCopyImageSubData(
+                pool.object,
+                GL_TEXTURE_2D_ARRAY,
+                level,
+                0,
+                0,
+                0,
+                object,
+                GL_TEXTURE_2D_ARRAY,
+                level,
+                0,
+                0,
+                0,
+                std::max(1, pool.width >> level),
+                std::max(1, pool.height >> level),
+                static_cast<GLsizei>(pool.capacity)));
+        }
+        m_state.forgetTexture(pool.object);
+        CALL_OPEN_GL(::glDeleteTextures(1, &pool.object));
+    }
+
+    // note : pushed backward so the lowest layers are given first
+    for (auto layer = capacity; layer != pool.capacity; layer--) { pool.free_layers.push_back(layer - 1); }
+
+    m_bytes += (capacity - pool.capacity) * pool.layer_bytes;
+    pool.object = object;
+    pool.capacity = capacity;
+}
+
+auto kawe::TextureCache::coarsest_level(std::span<const binary::TextureFile::Level> levels) noexcept -> std::size_t
+{
+    for (std::size_t level = 0; level != levels.size(); level++) {
+        if (std::max(levels[level].width, levels[level].height) <= MIN_RESIDENT_SIZE) { return level; }
+    }
+    return levels.size() - 1;
+}
+
+auto kawe::TextureCache::bytes_from(std::span<const binary::TextureFile::Level> levels, std::size_t level) noexcept
+    -> std::size_t
+{
+    std::size_t bytes = 0;
+    for (const auto &mip : levels.subspan(level)) { bytes += mip.data.size(); }
+    return bytes;
+}
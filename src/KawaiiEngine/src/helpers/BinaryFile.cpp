@@ -0,0 +1,34 @@
+#include <fstream>
+#include <thread>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "helpers/BinaryFile.hpp"
+
+auto kawe::BinaryFile::save(const std::filesystem::path &path, std::span<const std::uint8_t> bytes) -> bool
+{
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    // note : the same file may be cooked at once by different threads, each writes its own temporary
+    auto temporary = path;
+    temporary += fmt::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream file{temporary, std::ios::binary | std::ios::trunc};
+        if (!file.is_open()) {
+            spdlog::warn("BinaryFile: failed to open '{}'", temporary.string());
+            return false;
+        }
+        file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!file.good()) { return false; }
+    }
+
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+        spdlog::warn("BinaryFile: failed to write '{}': {}", path.string(), ec.message());
+        std::filesystem::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
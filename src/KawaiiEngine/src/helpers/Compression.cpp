@@ -0,0 +1,142 @@
+#include <array>
+#include <cstring>
+
+#include "helpers/Compression.hpp"
+
+namespace {
+
+constexpr std::size_t MIN_MATCH = 4;
+constexpr std::size_t LAST_LITERALS = 5;
+constexpr std::size_t MAX_OFFSET = 0xFFFF;
+constexpr std::uint32_t HASH_BITS = 12;
+
+auto read32(const std::uint8_t *p) noexcept -> std::uint32_t
+{
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+auto hash(std::uint32_t sequence) noexcept -> std::uint32_t { return (sequence * 2654435761u) >> (32 - HASH_BITS); }
+
+auto write_length(std::vector<std::uint8_t> &out, std::size_t length) -> void
+{
+    for (; length >= 255; length -= 255) { out.push_back(255); }
+    out.push_back(static_cast<std::uint8_t>(length));
+}
+
+auto write_sequence(
+    std::vector<std::uint8_t> &out, const std::uint8_t *literals, std::size_t literal_length, std::size_t offset, std::size_t match_length)
+    -> void
+{
+    const auto match_code = match_length - MIN_MATCH;
+    out.push_back(static_cast<std::uint8_t>(
+        (std::min<std::size_t>(literal_length, 15) << 4) | std::min<std::size_t>(match_code, 15)));
+
+    if (literal_length >= 15) { write_length(out, literal_length - 15); }
+    out.insert(out.end(), literals, literals + literal_length);
+
+    out.push_back(static_cast<std::uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<std::uint8_t>(offset >> 8));
+
+    if (match_code >= 15) { write_length(out, match_code - 15); }
+}
+
+auto write_last_literals(std::vector<std::uint8_t> &out, const std::uint8_t *literals, std::size_t literal_length)
+    -> void
+{
+    out.push_back(static_cast<std::uint8_t>(std::min<std::size_t>(literal_length, 15) << 4));
+    if (literal_length >= 15) { write_length(out, literal_length - 15); }
+    out.insert(out.end(), literals, literals + literal_length);
+}
+
+auto read_length(const std::uint8_t *&ip, const std::uint8_t *end, std::size_t &length) noexcept -> bool
+{
+    std::uint8_t byte{};
+    do {
+        if (ip == end) { return false; }
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+} // namespace
+
+auto kawe::compress_block(std::span<const std::uint8_t> in, std::vector<std::uint8_t> &out) -> void
+{
+    const auto base = in.data();
+    const auto size = in.size();
+
+    out.reserve(out.size() + size + size / 255 + 16);
+
+    std::size_t anchor = 0;
+    if (size > MIN_MATCH + LAST_LITERALS) {
+        // note : positions are stored + 1, so 0 means empty
+        std::array<std::uint32_t, 1u << HASH_BITS> table{};
+        const auto match_limit = size - LAST_LITERALS;
+
+        for (std::size_t ip = 0; ip + MIN_MATCH <= match_limit;) {
+            const auto sequence = read32(base + ip);
+            auto &entry = table[hash(sequence)];
+            const auto candidate = static_cast<std::size_t>(entry);
+            entry = static_cast<std::uint32_t>(ip + 1);
+
+            if (candidate == 0 || ip - (candidate - 1) > MAX_OFFSET || read32(base + candidate - 1) != sequence) {
+                ip++;
+                continue;
+            }
+
+            const auto ref = candidate - 1;
+            auto length = MIN_MATCH;
+            while (ip + length < match_limit && base[ref + length] == base[ip + length]) { length++; }
+
+            write_sequence(out, base + anchor, ip - anchor, ip - ref, length);
+            ip += length;
+            anchor = ip;
+        }
+    }
+
+    write_last_literals(out, base + anchor, size - anchor);
+}
+
+auto kawe::decompress_block(std::span<const std::uint8_t> in, std::span<std::uint8_t> out) noexcept -> bool
+{
+    auto ip = in.data();
+    const auto ip_end = in.data() + in.size();
+    auto op = out.data();
+    const auto op_end = out.data() + out.size();
+
+    while (ip != ip_end) {
+        const auto token = *ip++;
+
+        std::size_t literal_length = token >> 4;
+        if (literal_length == 15 && !read_length(ip, ip_end, literal_length)) { return false; }
+        if (static_cast<std::size_t>(ip_end - ip) < literal_length
+            || static_cast<std::size_t>(op_end - op) < literal_length) {
+            return false;
+        }
+        std::memcpy(op, ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+
+        // the last sequence only has literals
+        if (ip == ip_end) { break; }
+
+        if (ip_end - ip < 2) { return false; }
+        const auto offset = static_cast<std::size_t>(ip[0]) | (static_cast<std::size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<std::size_t>(op - out.data())) { return false; }
+
+        std::size_t match_length = token & 0x0F;
+        if (match_length == 15 && !read_length(ip, ip_end, match_length)) { return false; }
+        match_length += MIN_MATCH;
+        if (static_cast<std::size_t>(op_end - op) < match_length) { return false; }
+
+        // note : the match can overlap the output, copy byte per byte
+        const auto *match = op - offset;
+        for (std::size_t i = 0; i != match_length; i++) { *op++ = *match++; }
+    }
+
+    return op == op_end;
+}
@@ -0,0 +1,109 @@
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#ifdef _WIN32
+#    define WIN32_LEAN_AND_MEAN
+#    define NOMINMAX
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "helpers/MappedFile.hpp"
+
+kawe::MappedFile::MappedFile(const std::filesystem::path &path)
+{
+#ifdef _WIN32
+    m_file = ::CreateFileW(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        m_file = nullptr;
+        spdlog::error("MappedFile: failed to open '{}'", path.string());
+        return;
+    }
+
+    LARGE_INTEGER size{};
+    if (!::GetFileSizeEx(m_file, &size) || size.QuadPart == 0) { return release(); }
+
+    m_mapping = ::CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping == nullptr) {
+        spdlog::error("MappedFile: failed to map '{}'", path.string());
+        return release();
+    }
+
+    m_data = static_cast<const std::uint8_t *>(::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    if (m_data == nullptr) { return release(); }
+#else
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        spdlog::error("MappedFile: failed to open '{}'", path.string());
+        return;
+    }
+
+    struct stat info {};
+    if (::fstat(fd, &info) == -1 || info.st_size == 0) {
+        ::close(fd);
+        return;
+    }
+
+    const auto size = static_cast<std::size_t>(info.st_size);
+    const auto mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // note : the mapping stays valid once the descriptor is closed
+    ::close(fd);
+
+    if (mapped == MAP_FAILED) {
+        spdlog::error("MappedFile: failed to map '{}'", path.string());
+        return;
+    }
+
+    ::madvise(mapped, size, MADV_SEQUENTIAL);
+    m_data = static_cast<const std::uint8_t *>(mapped);
+    m_size = size;
+#endif
+}
+
+kawe::MappedFile::~MappedFile() { release(); }
+
+kawe::MappedFile::MappedFile(MappedFile &&other) noexcept :
+    m_data{std::exchange(other.m_data, nullptr)}, m_size{std::exchange(other.m_size, 0)}
+#ifdef _WIN32
+    ,
+    m_file{std::exchange(other.m_file, nullptr)},
+    m_mapping{std::exchange(other.m_mapping, nullptr)}
+#endif
+{
+}
+
+auto kawe::MappedFile::operator=(MappedFile &&other) noexcept -> MappedFile &
+{
+    if (this != &other) {
+        release();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+#ifdef _WIN32
+        m_file = std::exchange(other.m_file, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+auto kawe::MappedFile::release() noexcept -> void
+{
+#ifdef _WIN32
+    if (m_data != nullptr) { ::UnmapViewOfFile(m_data); }
+    if (m_mapping != nullptr) { ::CloseHandle(m_mapping); }
+    if (m_file != nullptr) { ::CloseHandle(m_file); }
+    m_file = nullptr;
+    m_mapping = nullptr;
+#else
+    if (m_data != nullptr) { ::munmap(const_cast<std::uint8_t *>(m_data), m_size); }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <fstream>
+#include <optional>
+
+#include "json/JsonEventReader.hpp"
+#include "json/SerializeEvent.hpp"
+
+namespace {
+
+/// Build one element of the top level array at a time, `on_element` is called once it is complete.
+template<typename OnElement>
+class ElementSaxHandler final : public nlohmann::json_sax<nlohmann::json> {
+public:
+    explicit ElementSaxHandler(OnElement on_element) : m_on_element{std::move(on_element)} {}
+
+    auto null() -> bool override { return value(nullptr); }
+    auto boolean(bool v) -> bool override { return value(v); }
+    auto number_integer(number_integer_t v) -> bool override { return value(v); }
+    auto number_unsigned(number_unsigned_t v) -> bool override { return value(v); }
+    auto number_float(number_float_t v, const string_t &) -> bool override { return value(v); }
+    auto string(string_t &v) -> bool override { return value(std::move(v)); }
+    auto binary(binary_t &v) -> bool override { return value(nlohmann::json::binary(std::move(v))); }
+
+    auto start_object(std::size_t) -> bool override
+    {
+        if (!m_in_array) { return false; }
+        return value(nlohmann::json::object());
+    }
+
+    auto key(string_t &v) -> bool override
+    {
+        m_key = std::move(v);
+        return true;
+    }
+
+    auto end_object() -> bool override { return end_container(); }
+
+    auto start_array(std::size_t) -> bool override
+    {
+        if (!m_in_array) {
+            m_in_array = true;
+            return true;
+        }
+        return value(nlohmann::json::array());
+    }
+
+    auto end_array() -> bool override
+    {
+        if (m_stack.empty()) {
+            m_in_array = false;
+            return true;
+        }
+        return end_container();
+    }
+
+    auto parse_error(std::size_t position, const std::string &, const nlohmann::detail::exception &e) -> bool override
+    {
+        spdlog::error("JsonEventReader: parse error at byte {}: {}", position, e.what());
+        return false;
+    }
+
+private:
+    OnElement m_on_element;
+    bool m_in_array{false};
+    nlohmann::json m_element;
+    std::vector<nlohmann::json *> m_stack;
+    std::string m_key;
+
+    auto value(nlohmann::json &&v) -> bool
+    {
+        if (!m_in_array) { return false; }
+
+        const auto is_container = v.is_structured();
+        nlohmann::json *inserted = nullptr;
+        if (m_stack.empty()) {
+            m_element = std::move(v);
+            inserted = &m_element;
+        } else if (auto &parent = *m_stack.back(); parent.is_array()) {
+            parent.push_back(std::move(v));
+            inserted = &parent.back();
+        } else {
+            inserted = &(parent[m_key] = std::move(v));
+        }
+
+        if (is_container) {
+            m_stack.push_back(inserted);
+            return true;
+        }
+        return m_stack.empty() ? m_on_element(std::move(m_element)) : true;
+    }
+
+    auto end_container() -> bool
+    {
+        m_stack.pop_back();
+        return m_stack.empty() ? m_on_element(std::move(m_element)) : true;
+    }
+};
+
+} // namespace
+
+kawe::JsonEventReader::JsonEventReader(std::filesystem::path path) : m_path{std::move(path)}
+{
+    if (!std::ifstream{m_path}.is_open()) {
+        spdlog::error("JsonEventReader: failed to open file: {}", m_path.string());
+        return;
+    }
+
+    m_valid = true;
+    start(0);
+}
+
+kawe::JsonEventReader::~JsonEventReader() { stop(); }
+
+auto kawe::JsonEventReader::next() -> std::optional<event::Event>
+{
+    if (m_chunk_cursor == m_chunk.size()) {
+        {
+            std::unique_lock lock{m_mutex};
+            m_cv.wait(lock, [this] { return !m_chunks.empty() || m_done; });
+            if (m_chunks.empty()) { return {}; }
+
+            m_chunk = std::move(m_chunks.front());
+            m_chunks.pop_front();
+        }
+        m_cv.notify_all();
+        m_chunk_cursor = 0;
+    }
+
+    m_position++;
+    return std::move(m_chunk[m_chunk_cursor++]);
+}
+
+auto kawe::JsonEventReader::size() const noexcept -> std::size_t
+{
+    std::lock_guard lock{m_mutex};
+    return std::max(m_parsed, m_position);
+}
+
+auto kawe::JsonEventReader::seek(std::size_t index) -> bool
+{
+    if (!m_valid) { return false; }
+
+    stop();
+    m_chunk.clear();
+    m_chunk_cursor = 0;
+    m_position = index;
+    start(index);
+    return true;
+}
+
+auto kawe::JsonEventReader::is_parsing() const noexcept -> bool
+{
+    std::lock_guard lock{m_mutex};
+    return !m_done;
+}
+
+auto kawe::JsonEventReader::start(std::size_t skip) -> void
+{
+    m_chunks.clear();
+    m_parsed = 0;
+    m_done = false;
+    m_stop = false;
+    m_parser = std::thread{[this, skip] { run(skip); }};
+}
+
+auto kawe::JsonEventReader::stop() -> void
+{
+    if (!m_parser.joinable()) { return; }
+
+    {
+        std::lock_guard lock{m_mutex};
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_parser.join();
+}
+
+auto kawe::JsonEventReader::run(std::size_t skip) -> void
+{
+    std::vector<event::Event> chunk;
+    chunk.reserve(CHUNK_SIZE);
+
+    const auto hand_over = [this, &chunk] {
+        {
+            std::unique_lock lock{m_mutex};
+            // note : wait for the player, so only a few chunks are in memory at once
+            m_cv.wait(lock, [this] { return m_stop || m_chunks.size() < MAX_PENDING_CHUNKS; });
+            if (m_stop) { return false; }
+            m_parsed += chunk.size();
+            m_chunks.push_back(std::move(chunk));
+        }
+        m_cv.notify_all();
+        chunk = {};
+        chunk.reserve(CHUNK_SIZE);
+        return true;
+    };
+
+    // note : runs on the parser thread, an element which can not be decoded is skipped rather than thrown out of it
+    const auto decode = [](const nlohmann::json &element) -> std::optional<event::Event> {
+        event::Event decoded;
+        try {
+            event::from_json(element, decoded);
+        } catch (const nlohmann::json::exception &e) {
+            spdlog::warn("JsonEventReader: skipping an invalid event: {}: {}", e.what(), element.dump());
+            return {};
+        }
+        if (std::holds_alternative<std::monostate>(decoded)) {
+            spdlog::warn("JsonEventReader: skipping an unknown event: {}", element.dump());
+            return {};
+        }
+        return decoded;
+    };
+
+    ElementSaxHandler handler{[&](nlohmann::json &&element) {
+        auto decoded = decode(element);
+        if (!decoded.has_value()) { return true; }
+
+        // note : the events before the seek target are counted like the played ones, the skipped elements are not
+        if (skip != 0) {
+            skip--;
+            std::lock_guard lock{m_mutex};
+            m_parsed++;
+            return !m_stop;
+        }
+
+        chunk.push_back(std::move(*decoded));
+        return chunk.size() != CHUNK_SIZE || hand_over();
+    }};
+
+    std::ifstream ifs{m_path};
+    nlohmann::json::sax_parse(ifs, &handler);
+
+    if (!chunk.empty()) { hand_over(); }
+
+    {
+        std::lock_guard lock{m_mutex};
+        m_done = true;
+    }
+    m_cv.notify_all();
+}
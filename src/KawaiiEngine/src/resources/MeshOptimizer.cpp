@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <numeric>
+
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+
+#include "resources/MeshOptimizer.hpp"
+#include "Profiler.hpp"
+
+namespace {
+
+using kawe::MeshOptimizer;
+using kawe::ObjMesh;
+
+/// position, normal and texcoord of a vertex, as bits
+using Key = std::array<std::uint32_t, 8>;
+
+auto bits_of(float value) noexcept -> std::uint32_t
+{
+    // note : -0 and 0 are the same vertex
+    return value == 0.0f ? 0u : std::bit_cast<std::uint32_t>(value);
+}
+
+auto hash_of(const Key &key) noexcept -> std::uint64_t
+{
+    std::uint64_t hash = 0;
+    for (const auto word : key) {
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+    }
+    return hash;
+}
+
+/// a FIFO cache of vertices, a vertex is cached if less than `cache_size` vertices have been transformed since it
+class CacheSimulation {
+public:
+    CacheSimulation(std::size_t vertex_count, std::size_t cache_size) :
+        m_timestamps(vertex_count, 0), m_cache_size{static_cast<std::uint32_t>(cache_size)}, m_time{m_cache_size + 1}
+    {
+    }
+
+    auto flush() noexcept -> void { m_time += m_cache_size + 1; }
+
+    /// the number of vertices of the triangle transformed
+    auto draw(std::span<const std::uint32_t> triangle) noexcept -> std::uint32_t
+    {
+        std::uint32_t misses = 0;
+        for (const auto vertex : triangle) {
+            if (m_time - m_timestamps[vertex] > m_cache_size) {
+                m_timestamps[vertex] = m_time++;
+                misses++;
+            }
+        }
+        return misses;
+    }
+
+private:
+    std::vector<std::uint32_t> m_timestamps;
+    std::uint32_t m_cache_size;
+    std::uint32_t m_time;
+};
+
+auto position_of(std::span<const float> positions, std::uint32_t vertex) noexcept -> glm::vec3
+{
+    return {positions[vertex * 3 + 0], positions[vertex * 3 + 1], positions[vertex * 3 + 2]};
+}
+
+} // namespace
+
+auto kawe::MeshOptimizer::weld(const ObjMesh &obj) -> Mesh
+{
+    KAWE_PROFILE_ZONE("mesh weld");
+
+    const auto attribute = [](const std::vector<float> &values, std::uint32_t index, std::size_t size, std::size_t i) {
+        return index == ObjMesh::NONE ? 0u : bits_of(values[index * size + i]);
+    };
+
+    // note : open addressing, the table is kept at most half full
+    const auto capacity = std::bit_ceil(std::max<std::size_t>(obj.corners.size() * 2, 16));
+    std::vector<std::uint32_t> table(capacity, ObjMesh::NONE);
+    std::vector<Key> vertices;
+
+    Mesh mesh;
+    mesh.indices.reserve(obj.corners.size());
+    for (const auto &corner : obj.corners) {
+        Key key{};
+        for (std::size_t i = 0; i != 3; i++) { key[i] = attribute(obj.positions, corner.position, 3, i); }
+        for (std::size_t i = 0; i != 3; i++) { key[3 + i] = attribute(obj.normals, corner.normal, 3, i); }
+        for (std::size_t i = 0; i != 2; i++) { key[6 + i] = attribute(obj.texcoords, corner.texcoord, 2, i); }
+
+        auto slot = hash_of(key) & (capacity - 1);
+        while (table[slot] != ObjMesh::NONE && vertices[table[slot]] != key) { slot = (slot + 1) & (capacity - 1); }
+        if (table[slot] == ObjMesh::NONE) {
+            table[slot] = static_cast<std::uint32_t>(vertices.size());
+            vertices.push_back(key);
+        }
+        mesh.indices.push_back(table[slot]);
+    }
+
+    mesh.positions.reserve(vertices.size() * 3);
+    mesh.normals.reserve(vertices.size() * 3);
+    mesh.texcoords.reserve(vertices.size() * 2);
+    for (const auto &key : vertices) {
+        for (std::size_t i = 0; i != 3; i++) { mesh.positions.push_back(std::bit_cast<float>(key[i])); }
+        for (std::size_t i = 3; i != 6; i++) { mesh.normals.push_back(std::bit_cast<float>(key[i])); }
+        for (std::size_t i = 6; i != 8; i++) { mesh.texcoords.push_back(std::bit_cast<float>(key[i])); }
+    }
+    return mesh;
+}
+
+auto kawe::MeshOptimizer::optimize_vertex_cache(std::span<std::uint32_t> indices, std::size_t vertex_count)
+    -> std::vector<std::size_t>
+{
+    KAWE_PROFILE_ZONE("mesh vertex cache");
+
+    const auto triangle_count = indices.size() / 3;
+
+    // note : the triangles using each vertex, as ranges of a single array
+    std::vector<std::uint32_t> offsets(vertex_count + 1, 0);
+    for (const auto index : indices) { offsets[index + 1]++; }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<std::uint32_t> adjacency(indices.size());
+    std::vector<std::uint32_t> filled(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i != indices.size(); i++) {
+        adjacency[filled[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+    }
+
+    // note : the number of triangles still to emit using each vertex
+    std::vector<std::uint32_t> live(vertex_count);
+    for (std::size_t i = 0; i != vertex_count; i++) { live[i] = offsets[i + 1] - offsets[i]; }
+
+    std::vector<std::uint32_t> timestamps(vertex_count, 0);
+    std::uint32_t time = CACHE_SIZE + 1;
+    std::vector<bool> emitted(triangle_count, false);
+    std::vector<std::uint32_t> dead_ends;
+    std::vector<std::uint32_t> candidates;
+    std::size_t cursor = 0;
+
+    std::vector<std::uint32_t> output;
+    output.reserve(indices.size());
+    std::vector<std::size_t> clusters;
+
+    // note : the most recent vertex having triangles left, or else the next one in order
+    const auto skip_dead_end = [&]() -> std::uint32_t {
+        while (!dead_ends.empty()) {
+            const auto vertex = dead_ends.back();
+            dead_ends.pop_back();
+            if (live[vertex] != 0) { return vertex; }
+        }
+        for (; cursor != vertex_count; cursor++) {
+            if (live[cursor] != 0) { return static_cast<std::uint32_t>(cursor); }
+        }
+        return ObjMesh::NONE;
+    };
+
+    auto fan = skip_dead_end();
+    if (fan != ObjMesh::NONE) { clusters.push_back(0); }
+    while (fan != ObjMesh::NONE) {
+        candidates.clear();
+        for (auto i = offsets[fan]; i != offsets[fan + 1]; i++) {
+            const auto triangle = adjacency[i];
+            if (emitted[triangle]) { continue; }
+            emitted[triangle] = true;
+
+            for (std::size_t corner = 0; corner != 3; corner++) {
+                const auto vertex = indices[triangle * 3 + corner];
+                output.push_back(vertex);
+                dead_ends.push_back(vertex);
+                candidates.push_back(vertex);
+                live[vertex]--;
+                if (time - timestamps[vertex] > CACHE_SIZE) { timestamps[vertex] = time++; }
+            }
+        }
+
+        // note : the next fan is the oldest candidate which will still be cached once its triangles are emitted
+        fan = ObjMesh::NONE;
+        std::int64_t best = -1;
+        for (const auto vertex : candidates) {
+            if (live[vertex] == 0) { continue; }
+            std::int64_t priority = 0;
+            if (time - timestamps[vertex] + 2 * live[vertex] <= CACHE_SIZE) { priority = time - timestamps[vertex]; }
+            if (priority > best) {
+                best = priority;
+                fan = vertex;
+            }
+        }
+        if (fan == ObjMesh::NONE) {
+            fan = skip_dead_end();
+            if (fan != ObjMesh::NONE) { clusters.push_back(output.size() / 3); }
+        }
+    }
+
+    std::ranges::copy(output, indices.begin());
+    return clusters;
+}
+
+auto kawe::MeshOptimizer::optimize_overdraw(
+    std::span<std::uint32_t> indices, std::span<const float> positions, std::span<const std::size_t> clusters) -> void
+{
+    KAWE_PROFILE_ZONE("mesh overdraw");
+
+    const auto triangle_count = indices.size() / 3;
+    if (triangle_count == 0 || clusters.empty()) { return; }
+    const auto triangle = [&indices](std::size_t i) { return indices.subspan(i * 3, 3); };
+
+    // note : a cluster is split where the miss ratio since its start is low enough, the cache flush costs little there
+    CacheSimulation cache{positions.size() / 3, CACHE_SIZE};
+    std::vector<std::size_t> starts;
+    for (std::size_t cluster = 0; cluster != clusters.size(); cluster++) {
+        const auto begin = clusters[cluster];
+        const auto end = cluster + 1 == clusters.size() ? triangle_count : clusters[cluster + 1];
+
+        cache.flush();
+        std::uint32_t misses = 0;
+        for (auto i = begin; i != end; i++) { misses += cache.draw(triangle(i)); }
+        const auto threshold = OVERDRAW_THRESHOLD * static_cast<float>(misses) / static_cast<float>(end - begin);
+
+        starts.push_back(begin);
+        cache.flush();
+        std::uint32_t running_misses = 0;
+        std::uint32_t running_triangles = 0;
+        for (auto i = begin; i != end; i++) {
+            running_misses += cache.draw(triangle(i));
+            running_triangles++;
+            const auto ratio = static_cast<float>(running_misses) / static_cast<float>(running_triangles);
+            if (i + 1 != end && ratio <= threshold) {
+                starts.push_back(i + 1);
+                cache.flush();
+                running_misses = 0;
+                running_triangles = 0;
+            }
+        }
+    }
+    starts.push_back(triangle_count);
+
+    // note : the clusters facing away from the center of the mesh are the likeliest to occlude the others
+    auto center = glm::vec3{0.0f};
+    for (const auto index : indices) { center += position_of(positions, index); }
+    center /= static_cast<float>(indices.size());
+
+    std::vector<float> keys(starts.size() - 1);
+    for (std::size_t cluster = 0; cluster != keys.size(); cluster++) {
+        auto centroid = glm::vec3{0.0f};
+        auto normal = glm::vec3{0.0f};
+        for (auto i = starts[cluster]; i != starts[cluster + 1]; i++) {
+            const auto a = position_of(positions, indices[i * 3 + 0]);
+            const auto b = position_of(positions, indices[i * 3 + 1]);
+            const auto c = position_of(positions, indices[i * 3 + 2]);
+            centroid += a + b + c;
+            // note : not normalized, the larger triangles weigh more
+            normal += glm::cross(b - a, c - a);
+        }
+        centroid /= static_cast<float>((starts[cluster + 1] - starts[cluster]) * 3);
+        const auto length = glm::length(normal);
+        keys[cluster] = length == 0.0f ? 0.0f : glm::dot(centroid - center, normal / length);
+    }
+
+    std::vector<std::size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order, [&keys](auto lhs, auto rhs) { return keys[lhs] > keys[rhs]; });
+
+    std::vector<std::uint32_t> output;
+    output.reserve(indices.size());
+    for (const auto cluster : order) {
+        const auto first = indices.begin() + static_cast<std::ptrdiff_t>(starts[cluster] * 3);
+        const auto last = indices.begin() + static_cast<std::ptrdiff_t>(starts[cluster + 1] * 3);
+        output.insert(output.end(), first, last);
+    }
+    std::ranges::copy(output, indices.begin());
+}
+
+auto kawe::MeshOptimizer::optimize_vertex_fetch(Mesh &mesh) -> void
+{
+    KAWE_PROFILE_ZONE("mesh vertex fetch");
+
+    std::vector<std::uint32_t> remap(mesh.vertex_count(), ObjMesh::NONE);
+    std::uint32_t next = 0;
+    for (auto &index : mesh.indices) {
+        if (remap[index] == ObjMesh::NONE) { remap[index] = next++; }
+        index = remap[index];
+    }
+
+    // note : the vertices used by no triangle are dropped
+    Mesh reordered;
+    reordered.positions.resize(std::size_t{next} * 3);
+    reordered.normals.resize(std::size_t{next} * 3);
+    reordered.texcoords.resize(std::size_t{next} * 2);
+    for (std::size_t vertex = 0; vertex != remap.size(); vertex++) {
+        const auto to = remap[vertex];
+        if (to == ObjMesh::NONE) { continue; }
+        std::copy_n(&mesh.positions[vertex * 3], 3, &reordered.positions[std::size_t{to} * 3]);
+        std::copy_n(&mesh.normals[vertex * 3], 3, &reordered.normals[std::size_t{to} * 3]);
+        std::copy_n(&mesh.texcoords[vertex * 2], 2, &reordered.texcoords[std::size_t{to} * 2]);
+    }
+    mesh.positions = std::move(reordered.positions);
+    mesh.normals = std::move(reordered.normals);
+    mesh.texcoords = std::move(reordered.texcoords);
+}
+
+auto kawe::MeshOptimizer::optimize(Mesh &mesh) -> void
+{
+    const auto clusters = optimize_vertex_cache(mesh.indices, mesh.vertex_count());
+    optimize_overdraw(mesh.indices, mesh.positions, clusters);
+    optimize_vertex_fetch(mesh);
+}
+
+auto kawe::MeshOptimizer::acmr(std::span<const std::uint32_t> indices, std::size_t vertex_count, std::size_t cache_size)
+    -> float
+{
+    const auto triangle_count = indices.size() / 3;
+    if (triangle_count == 0) { return 0.0f; }
+
+    CacheSimulation cache{vertex_count, cache_size};
+    std::size_t misses = 0;
+    for (std::size_t i = 0; i != triangle_count; i++) { misses += cache.draw(indices.subspan(i * 3, 3)); }
+    return static_cast<float>(misses) / static_cast<float>(triangle_count);
+}
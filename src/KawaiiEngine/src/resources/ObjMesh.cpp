@@ -0,0 +1,292 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <future>
+#include <string_view>
+#include <thread>
+
+#include <spdlog/spdlog.h>
+
+#include "resources/ObjMesh.hpp"
+#include "helpers/MappedFile.hpp"
+#include "Profiler.hpp"
+
+namespace {
+
+using kawe::ObjMesh;
+
+enum Attribute : std::size_t { POSITION, TEXCOORD, NORMAL, ATTRIBUTE_COUNT };
+
+constexpr auto MISSING = std::numeric_limits<std::int64_t>::min();
+
+/// a corner as written in the file, its relative indices are counted from the start of its chunk
+struct RawCorner {
+    std::array<std::int64_t, ATTRIBUTE_COUNT> index;
+    std::uint8_t relative;
+};
+
+struct Chunk {
+    std::vector<float> positions;
+    std::vector<float> texcoords;
+    std::vector<float> normals;
+    std::vector<RawCorner> corners;
+    std::size_t skipped{0};
+
+    auto count(Attribute attribute) const noexcept -> std::size_t
+    {
+        switch (attribute) {
+        case POSITION: return positions.size() / 3;
+        case TEXCOORD: return texcoords.size() / 2;
+        default: return normals.size() / 3;
+        }
+    }
+};
+
+auto skip_spaces(const char *&it, const char *end) noexcept -> void
+{
+    while (it != end && (*it == ' ' || *it == '\t')) { it++; }
+}
+
+auto read_float(const char *&it, const char *end, float &value) noexcept -> bool
+{
+    skip_spaces(it, end);
+    // note : from_chars does not take the sign '+'
+    if (it != end && *it == '+') { it++; }
+    const auto [next, ec] = std::from_chars(it, end, value);
+    if (ec != std::errc{}) { return false; }
+    it = next;
+    return true;
+}
+
+/// `required` floats then up to `optional` more, the missing ones are 0
+auto read_floats(const char *&it, const char *end, std::vector<float> &out, int required, int optional) -> bool
+{
+    for (int i = 0; i != required + optional; i++) {
+        float value = 0.0f;
+        if (!read_float(it, end, value)) {
+            if (i < required) { return false; }
+            value = 0.0f;
+        }
+        out.push_back(value);
+    }
+    return true;
+}
+
+/// an index of a face, 1 based or negative from the last attribute read, as an absolute or a relative 0 based index
+auto read_index(const char *&it, const char *end, std::size_t count, std::int64_t &index, bool &relative) noexcept
+    -> bool
+{
+    std::int64_t value = 0;
+    const auto [next, ec] = std::from_chars(it, end, value);
+    if (ec != std::errc{} || value == 0) { return false; }
+    it = next;
+
+    relative = value < 0;
+    index = relative ? static_cast<std::int64_t>(count) + value : value - 1;
+    return true;
+}
+
+auto read_corner(const char *&it, const char *end, const Chunk &chunk, RawCorner &corner) noexcept -> bool
+{
+    corner = {{MISSING, MISSING, MISSING}, 0};
+
+    const auto read = [&](Attribute attribute) {
+        bool relative = false;
+        if (!read_index(it, end, chunk.count(attribute), corner.index[attribute], relative)) { return false; }
+        if (relative) { corner.relative |= static_cast<std::uint8_t>(1u << attribute); }
+        return true;
+    };
+
+    if (!read(POSITION)) { return false; }
+    if (it == end || *it != '/') { return true; }
+    it++;
+    // note : `v//vn` has no texcoord
+    if (it != end && *it != '/' && !read(TEXCOORD)) { return false; }
+    if (it == end || *it != '/') { return true; }
+    it++;
+    return read(NORMAL);
+}
+
+auto read_face(const char *it, const char *end, Chunk &chunk, std::vector<RawCorner> &polygon) -> bool
+{
+    polygon.clear();
+    while (true) {
+        skip_spaces(it, end);
+        if (it == end) { break; }
+        RawCorner corner{};
+        if (!read_corner(it, end, chunk, corner)) { return false; }
+        polygon.push_back(corner);
+    }
+    if (polygon.size() < 3) { return false; }
+
+    for (std::size_t i = 2; i != polygon.size(); i++) {
+        chunk.corners.push_back(polygon[0]);
+        chunk.corners.push_back(polygon[i - 1]);
+        chunk.corners.push_back(polygon[i]);
+    }
+    return true;
+}
+
+auto read_line(const char *it, const char *end, Chunk &chunk, std::vector<RawCorner> &polygon) -> bool
+{
+    skip_spaces(it, end);
+    const auto *keyword_end = std::find_if(it, end, [](char c) { return c == ' ' || c == '\t'; });
+    const auto keyword = std::string_view{it, static_cast<std::size_t>(keyword_end - it)};
+    it = keyword_end;
+
+    if (keyword == "v") { return read_floats(it, end, chunk.positions, 3, 0); }
+    if (keyword == "vt") { return read_floats(it, end, chunk.texcoords, 1, 1); }
+    if (keyword == "vn") { return read_floats(it, end, chunk.normals, 3, 0); }
+    if (keyword == "f") { return read_face(it, end, chunk, polygon); }
+    return true;
+}
+
+auto read_chunk(std::span<const std::uint8_t> bytes) -> Chunk
+{
+    KAWE_PROFILE_ZONE("obj chunk");
+
+    Chunk chunk;
+    std::vector<RawCorner> polygon;
+    const auto *it = reinterpret_cast<const char *>(bytes.data());
+    const auto *end = it + bytes.size();
+    while (it != end) {
+        const auto *line_end = static_cast<const char *>(std::memchr(it, '\n', static_cast<std::size_t>(end - it)));
+        if (line_end == nullptr) { line_end = end; }
+
+        auto *content_end = line_end;
+        if (content_end != it && content_end[-1] == '\r') { content_end--; }
+        if (!read_line(it, content_end, chunk, polygon)) { chunk.skipped++; }
+
+        it = line_end == end ? end : line_end + 1;
+    }
+    return chunk;
+}
+
+/// the start of each chunk, the first byte of a line, and the end of the file
+auto split(std::span<const std::uint8_t> bytes, std::size_t threads) -> std::vector<std::size_t>
+{
+    const auto count =
+        std::clamp<std::size_t>(bytes.size() / ObjMesh::MIN_CHUNK_SIZE, 1, std::max<std::size_t>(threads, 1));
+
+    std::vector<std::size_t> bounds{0};
+    for (std::size_t i = 1; i != count; i++) {
+        const auto from = std::max(bytes.size() * i / count, bounds.back());
+        const auto *line_end = std::memchr(bytes.data() + from, '\n', bytes.size() - from);
+        const auto bound = line_end == nullptr ? bytes.size()
+                                               : static_cast<std::size_t>(
+                                                   static_cast<const std::uint8_t *>(line_end) - bytes.data() + 1);
+        if (bound != bounds.back() && bound != bytes.size()) { bounds.push_back(bound); }
+    }
+    bounds.push_back(bytes.size());
+    return bounds;
+}
+
+/// copy the attributes of a chunk and resolve its indices, at its offsets in the merged mesh
+auto merge_chunk(
+    const Chunk &chunk,
+    const std::array<std::size_t, ATTRIBUTE_COUNT> &offsets,
+    std::size_t first_corner,
+    ObjMesh &mesh) -> bool
+{
+    KAWE_PROFILE_ZONE("obj merge");
+
+    std::ranges::copy(chunk.positions, mesh.positions.begin() + static_cast<std::ptrdiff_t>(offsets[POSITION] * 3));
+    std::ranges::copy(chunk.texcoords, mesh.texcoords.begin() + static_cast<std::ptrdiff_t>(offsets[TEXCOORD] * 2));
+    std::ranges::copy(chunk.normals, mesh.normals.begin() + static_cast<std::ptrdiff_t>(offsets[NORMAL] * 3));
+
+    const std::array<std::size_t, ATTRIBUTE_COUNT> totals{
+        mesh.positions.size() / 3, mesh.texcoords.size() / 2, mesh.normals.size() / 3};
+
+    for (std::size_t i = 0; i != chunk.corners.size(); i++) {
+        const auto &raw = chunk.corners[i];
+        std::array<std::uint32_t, ATTRIBUTE_COUNT> resolved{};
+        for (std::size_t attribute = 0; attribute != ATTRIBUTE_COUNT; attribute++) {
+            if (raw.index[attribute] == MISSING) {
+                resolved[attribute] = ObjMesh::NONE;
+                continue;
+            }
+            const auto relative = (raw.relative >> attribute) & 1u;
+            const auto index = raw.index[attribute] + (relative ? static_cast<std::int64_t>(offsets[attribute]) : 0);
+            if (index < 0 || static_cast<std::size_t>(index) >= totals[attribute]) { return false; }
+            resolved[attribute] = static_cast<std::uint32_t>(index);
+        }
+        mesh.corners[first_corner + i] = {resolved[POSITION], resolved[TEXCOORD], resolved[NORMAL]};
+    }
+    return true;
+}
+
+} // namespace
+
+auto kawe::ObjMesh::default_threads() noexcept -> std::size_t
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+auto kawe::ObjMesh::load(const std::filesystem::path &filepath, std::size_t threads) -> std::optional<ObjMesh>
+{
+    KAWE_PROFILE_ZONE("obj load");
+
+    const MappedFile file{filepath};
+    if (!file.is_open()) {
+        spdlog::error("ObjMesh: failed to open '{}'", filepath.string());
+        return {};
+    }
+
+    // note : the first chunk is read by the calling thread, the others each by a thread of their own
+    const auto bounds = split(file.bytes(), threads);
+    const auto chunk_count = bounds.size() - 1;
+    const auto chunk_bytes = [&](std::size_t i) { return file.bytes().subspan(bounds[i], bounds[i + 1] - bounds[i]); };
+
+    std::vector<std::future<Chunk>> reading;
+    for (std::size_t i = 1; i < chunk_count; i++) {
+        reading.push_back(std::async(std::launch::async, [&chunk_bytes, i] { return read_chunk(chunk_bytes(i)); }));
+    }
+    std::vector<Chunk> chunks;
+    chunks.reserve(chunk_count);
+    chunks.push_back(read_chunk(chunk_bytes(0)));
+    for (auto &chunk : reading) { chunks.push_back(chunk.get()); }
+
+    // note : the offsets of each chunk in the merged mesh, counted in attributes and in corners
+    std::vector<std::array<std::size_t, ATTRIBUTE_COUNT>> offsets(chunk_count);
+    std::vector<std::size_t> first_corners(chunk_count);
+    std::array<std::size_t, ATTRIBUTE_COUNT> totals{};
+    std::size_t corner_count = 0;
+    std::size_t skipped = 0;
+    for (std::size_t i = 0; i != chunk_count; i++) {
+        offsets[i] = totals;
+        first_corners[i] = corner_count;
+        for (std::size_t attribute = 0; attribute != ATTRIBUTE_COUNT; attribute++) {
+            totals[attribute] += chunks[i].count(static_cast<Attribute>(attribute));
+        }
+        corner_count += chunks[i].corners.size();
+        skipped += chunks[i].skipped;
+    }
+
+    if (std::ranges::any_of(totals, [](auto total) { return total >= NONE; })) {
+        spdlog::error("ObjMesh: '{}' has too many vertices to be indexed", filepath.string());
+        return {};
+    }
+    if (skipped != 0) { spdlog::warn("ObjMesh: {} malformed lines skipped in '{}'", skipped, filepath.string()); }
+
+    ObjMesh mesh;
+    mesh.positions.resize(totals[POSITION] * 3);
+    mesh.texcoords.resize(totals[TEXCOORD] * 2);
+    mesh.normals.resize(totals[NORMAL] * 3);
+    mesh.corners.resize(corner_count);
+
+    std::vector<std::future<bool>> merging;
+    for (std::size_t i = 1; i < chunk_count; i++) {
+        merging.push_back(std::async(std::launch::async, [&, i] {
+            return merge_chunk(chunks[i], offsets[i], first_corners[i], mesh);
+        }));
+    }
+    auto valid = merge_chunk(chunks[0], offsets[0], first_corners[0], mesh);
+    for (auto &merged : merging) { valid = merged.get() && valid; }
+
+    if (!valid) {
+        spdlog::error("ObjMesh: '{}' has a face indexing a vertex which does not exist", filepath.string());
+        return {};
+    }
+    return mesh;
+}
@@ -0,0 +1,95 @@
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "helpers/Compression.hpp"
+
+namespace {
+
+auto round_trip(std::span<const std::uint8_t> in) -> std::vector<std::uint8_t>
+{
+    std::vector<std::uint8_t> compressed;
+    kawe::compress_block(in, compressed);
+
+    std::vector<std::uint8_t> out(in.size());
+    REQUIRE(kawe::decompress_block(compressed, out));
+    return out;
+}
+
+auto random_bytes(std::size_t size) -> std::vector<std::uint8_t>
+{
+    std::mt19937 rng{42};
+    std::vector<std::uint8_t> bytes(size);
+    for (auto &byte : bytes) { byte = static_cast<std::uint8_t>(std::uniform_int_distribution<int>{0, 255}(rng)); }
+    return bytes;
+}
+
+} // namespace
+
+TEST_CASE("a repetitive block is compressed and restored", "[Compression]")
+{
+    constexpr std::string_view pattern{"TimeElapsed 16ms, Moved<Mouse> 12 -3, "};
+    std::vector<std::uint8_t> in;
+    for (auto i = 0; i != 1000; i++) { in.insert(in.end(), pattern.begin(), pattern.end()); }
+
+    std::vector<std::uint8_t> compressed;
+    kawe::compress_block(in, compressed);
+    CHECK(compressed.size() < in.size() / 10);
+
+    CHECK(round_trip(in) == in);
+}
+
+TEST_CASE("an empty block is restored as an empty block", "[Compression]")
+{
+    const std::vector<std::uint8_t> in;
+    CHECK(round_trip(in).empty());
+}
+
+TEST_CASE("an incompressible block is restored as is", "[Compression]")
+{
+    for (const auto size : {std::size_t{1}, std::size_t{5}, std::size_t{13}, std::size_t{70'000}}) {
+        const auto in = random_bytes(size);
+
+        std::vector<std::uint8_t> compressed;
+        kawe::compress_block(in, compressed);
+        // note : the literals are copied in runs, each costs a few bytes of length on top of the data
+        CHECK(compressed.size() <= in.size() + in.size() / 255 + 16);
+
+        CHECK(round_trip(in) == in);
+    }
+}
+
+TEST_CASE("compress_block appends to the output", "[Compression]")
+{
+    const auto in = random_bytes(100);
+    std::vector<std::uint8_t> compressed{1, 2, 3};
+    kawe::compress_block(in, compressed);
+
+    CHECK(compressed[0] == 1);
+    std::vector<std::uint8_t> out(in.size());
+    CHECK(kawe::decompress_block(std::span{compressed}.subspan(3), out));
+    CHECK(out == in);
+}
+
+TEST_CASE("a corrupted block is refused", "[Compression]")
+{
+    std::vector<std::uint8_t> in(4096, 'a');
+    std::vector<std::uint8_t> compressed;
+    kawe::compress_block(in, compressed);
+
+    SECTION("truncated")
+    {
+        std::vector<std::uint8_t> out(in.size());
+        CHECK_FALSE(kawe::decompress_block(std::span{compressed}.first(compressed.size() / 2), out));
+    }
+
+    SECTION("restored in a buffer of the wrong size")
+    {
+        std::vector<std::uint8_t> smaller(in.size() - 1);
+        CHECK_FALSE(kawe::decompress_block(compressed, smaller));
+        std::vector<std::uint8_t> larger(in.size() + 1);
+        CHECK_FALSE(kawe::decompress_block(compressed, larger));
+    }
+}
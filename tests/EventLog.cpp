@@ -0,0 +1,131 @@
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "binary/EventLog.hpp"
+#include "json/SerializeEvent.hpp"
+
+namespace {
+
+using namespace std::chrono_literals;
+using namespace kawe;
+
+/// the events have no equality, they are compared through their json
+auto to_json(const std::vector<event::Event> &events) -> nlohmann::json
+{
+    auto out = nlohmann::json::array();
+    for (const auto &e : events) {
+        nlohmann::json j;
+        event::to_json(j, e);
+        out.push_back(std::move(j));
+    }
+    return out;
+}
+
+auto make_events(std::size_t count) -> std::vector<event::Event>
+{
+    std::vector<event::Event> events;
+    for (std::size_t i = 0; i != count; i++) {
+        const auto value = static_cast<double>(i);
+        switch (i % 5) {
+        case 0: events.emplace_back(event::TimeElapsed{16ms + std::chrono::nanoseconds{i}, 16ms * i, 1}); break;
+        // note : integral coordinates are delta encoded, the others are kept as doubles
+        case 1: events.emplace_back(event::Moved<event::Mouse>{{}, value, -value}); break;
+        case 2: events.emplace_back(event::Moved<event::Mouse>{{}, value + 0.25, 1e300}); break;
+        case 3:
+            events.emplace_back(
+                event::Pressed<event::MouseButton>{{event::MouseButton::Button::BUTTON_RIGHT, {}}});
+            break;
+        default: events.emplace_back(event::Character{static_cast<std::uint32_t>(0x1F600 + i)}); break;
+        }
+    }
+    return events;
+}
+
+auto read_all(EventSource &reader) -> std::vector<event::Event>
+{
+    std::vector<event::Event> events;
+    while (auto e = reader.next()) { events.push_back(std::move(*e)); }
+    return events;
+}
+
+struct TemporaryLog {
+    std::filesystem::path path{
+        std::filesystem::temp_directory_path() / ("kawe_test" + std::string{binary::EventLogFormat::EXTENSION})};
+
+    ~TemporaryLog()
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+};
+
+} // namespace
+
+TEST_CASE("the events written in a log are read back", "[EventLog]")
+{
+    const TemporaryLog log;
+    const auto events = make_events(10'000);
+    const auto compress = GENERATE(true, false);
+
+    {
+        binary::EventLogWriter writer{log.path, compress};
+        REQUIRE(writer.is_open());
+        // note : blocks of uneven sizes, the delta state is reset at each of them
+        for (std::size_t first = 0; first < events.size(); first += 3001) {
+            writer.write(std::span{events}.subspan(first, std::min<std::size_t>(3001, events.size() - first)));
+        }
+        CHECK(writer.size() == events.size());
+    }
+
+    binary::EventLogReader reader{log.path};
+    REQUIRE(reader.is_open());
+    CHECK(reader.size() == events.size());
+    CHECK(to_json(read_all(reader)) == to_json(events));
+    CHECK(reader.remaining() == 0);
+}
+
+TEST_CASE("a seek only decodes from the event asked", "[EventLog]")
+{
+    const TemporaryLog log;
+    const auto events = make_events(1000);
+    {
+        binary::EventLogWriter writer{log.path};
+        writer.write(std::span{events}.first(400));
+        writer.write(std::span{events}.subspan(400));
+    }
+
+    binary::EventLogReader reader{log.path};
+    REQUIRE(reader.is_open());
+    for (const std::size_t index : {std::size_t{650}, std::size_t{0}, std::size_t{399}, std::size_t{400}}) {
+        REQUIRE(reader.seek(index));
+        CHECK(reader.remaining() == events.size() - index);
+        const auto expected = to_json({events.begin() + static_cast<std::ptrdiff_t>(index), events.end()});
+        CHECK(to_json(read_all(reader)) == expected);
+    }
+    CHECK_FALSE(reader.seek(events.size() + 1));
+}
+
+TEST_CASE("a log without any block is empty", "[EventLog]")
+{
+    const TemporaryLog log;
+    {
+        const binary::EventLogWriter writer{log.path};
+    }
+
+    binary::EventLogReader reader{log.path};
+    REQUIRE(reader.is_open());
+    CHECK(reader.size() == 0);
+    CHECK_FALSE(reader.next().has_value());
+}
+
+TEST_CASE("a file which is not a log is refused", "[EventLog]")
+{
+    const TemporaryLog log;
+    std::ofstream{log.path} << "[{\"not\": \"a log\"}]";
+
+    const binary::EventLogReader reader{log.path};
+    CHECK_FALSE(reader.is_open());
+}
@@ -0,0 +1,42 @@
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "FrameStats.hpp"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("the time of a section is recorded once its frame ends", "[FrameStats]")
+{
+    kawe::FrameStats stats;
+    stats.add("physics", 2ms);
+    stats.add("physics", 3ms);
+    stats.record_frame(16ms);
+
+    const auto sections = stats.getSections();
+    REQUIRE(sections.size() == 1);
+    CHECK(sections[0].name == "physics");
+    CHECK(sections[0].last == 5ms);
+    CHECK(sections[0].histogram.count() == 1);
+    CHECK(stats.getFrameHistogram().count() == 1);
+}
+
+TEST_CASE("the sections past the limit are gathered apart", "[FrameStats]")
+{
+    kawe::FrameStats stats;
+
+    // note : the names must outlive the stats
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i != kawe::FrameStats::MAX_SECTIONS + 8; i++) { names.push_back(std::to_string(i)); }
+    for (const auto &name : names) { stats.add(name, 1ms); }
+    stats.record_frame(16ms);
+
+    const auto sections = stats.getSections();
+    REQUIRE(sections.size() == kawe::FrameStats::MAX_SECTIONS + 1);
+    // note : the last section registered within the limit keeps its own name and time
+    CHECK(sections[kawe::FrameStats::MAX_SECTIONS - 1].name == names[kawe::FrameStats::MAX_SECTIONS - 1]);
+    CHECK(sections[kawe::FrameStats::MAX_SECTIONS - 1].last == 1ms);
+    CHECK(sections.back().name == kawe::FrameStats::OTHERS_NAME);
+    CHECK(sections.back().last == 8ms);
+}
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "helpers/Histogram.hpp"
+
+using Histogram = kawe::Histogram<>;
+
+TEST_CASE("an empty histogram has no percentile", "[Histogram]")
+{
+    const Histogram histogram;
+
+    CHECK(histogram.count() == 0);
+    CHECK(histogram.percentile(0.5) == 0);
+    CHECK(histogram.min() == 0);
+    CHECK(histogram.max() == 0);
+    CHECK(histogram.mean() == 0.0);
+}
+
+TEST_CASE("the small values are recorded exactly", "[Histogram]")
+{
+    Histogram histogram;
+    // note : below 2 * SUB_BUCKET_COUNT each value has a bucket of its own
+    for (std::uint64_t value = 1; value <= 100; value++) { histogram.record(value); }
+
+    CHECK(histogram.percentile(0.0) == 1);
+    CHECK(histogram.percentile(0.5) == 50);
+    CHECK(histogram.percentile(0.9) == 90);
+    CHECK(histogram.percentile(0.99) == 99);
+    CHECK(histogram.percentile(1.0) == 100);
+    CHECK(histogram.mean() == Approx(50.5));
+}
+
+TEST_CASE("a percentile is within the relative error of its bucket", "[Histogram]")
+{
+    std::mt19937_64 rng{42};
+    // note : frame times in nanoseconds, from 1us to 1s
+    std::lognormal_distribution<double> distribution{16.0, 1.5};
+
+    Histogram histogram;
+    std::vector<std::uint64_t> values;
+    for (auto i = 0; i != 100'000; i++) {
+        const auto value = static_cast<std::uint64_t>(std::clamp(distribution(rng), 1e3, 1e9));
+        histogram.record(value);
+        values.push_back(value);
+    }
+    std::ranges::sort(values);
+
+    const auto max_error = 1.0 / static_cast<double>(Histogram::SUB_BUCKET_COUNT);
+    for (const auto q : {0.01, 0.25, 0.5, 0.9, 0.99, 0.999}) {
+        const auto rank = static_cast<std::size_t>(std::ceil(q * static_cast<double>(values.size())));
+        const auto exact = static_cast<double>(values[rank - 1]);
+        const auto estimated = static_cast<double>(histogram.percentile(q));
+        CHECK(estimated >= exact);
+        CHECK((estimated - exact) / exact <= max_error);
+    }
+    CHECK(histogram.min() == values.front());
+    CHECK(histogram.max() == values.back());
+}
+
+TEST_CASE("a value is below the upper bound of its bucket and above the previous one", "[Histogram]")
+{
+    std::mt19937_64 rng{42};
+    for (auto i = 0; i != 10'000; i++) {
+        const auto value = rng() & Histogram::MAX_VALUE;
+        const auto index = Histogram::index_of(value);
+
+        REQUIRE(index < Histogram::BUCKET_COUNT);
+        CHECK(value <= Histogram::upper_bound_of(index));
+        if (index != 0) { CHECK(Histogram::upper_bound_of(index - 1) < value); }
+    }
+    CHECK(Histogram::index_of(Histogram::MAX_VALUE) == Histogram::BUCKET_COUNT - 1);
+}
+
+TEST_CASE("a value past the range is counted in the last bucket", "[Histogram]")
+{
+    Histogram histogram;
+    histogram.record(10);
+    histogram.record(Histogram::MAX_VALUE * 4);
+
+    CHECK(histogram.max() == Histogram::MAX_VALUE * 4);
+    CHECK(histogram.percentile(1.0) <= histogram.max());
+    CHECK(histogram.percentile(1.0) >= Histogram::MAX_VALUE);
+    CHECK(histogram.percentile(0.5) == 10);
+}
+
+TEST_CASE("reset forgets every value", "[Histogram]")
+{
+    Histogram histogram;
+    histogram.record(1'000);
+    histogram.reset();
+
+    CHECK(histogram.count() == 0);
+    histogram.record(5);
+    CHECK(histogram.min() == 5);
+    CHECK(histogram.percentile(1.0) == 5);
+}
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "resources/MeshOptimizer.hpp"
+
+namespace {
+
+using kawe::MeshOptimizer;
+using kawe::ObjMesh;
+
+constexpr auto NONE = ObjMesh::NONE;
+
+/// the attributes of the three vertices of a triangle
+using Triangle = std::array<std::array<float, 8>, 3>;
+
+/// the triangles of a mesh whatever their order and the order of their vertices, only their winding is kept
+auto triangles_of(const MeshOptimizer::Mesh &mesh) -> std::vector<Triangle>
+{
+    std::vector<Triangle> triangles;
+    for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        Triangle triangle{};
+        for (std::size_t k = 0; k != 3; k++) {
+            const auto v = mesh.indices[i + k];
+            triangle[k] = {
+                mesh.positions[v * 3],
+                mesh.positions[v * 3 + 1],
+                mesh.positions[v * 3 + 2],
+                mesh.normals[v * 3],
+                mesh.normals[v * 3 + 1],
+                mesh.normals[v * 3 + 2],
+                mesh.texcoords[v * 2],
+                mesh.texcoords[v * 2 + 1]};
+        }
+        std::ranges::rotate(triangle, std::ranges::min_element(triangle));
+        triangles.push_back(triangle);
+    }
+    std::ranges::sort(triangles);
+    return triangles;
+}
+
+/// a bumpy grid of `size` x `size` quads, its triangles shuffled
+auto grid(std::uint32_t size) -> ObjMesh
+{
+    ObjMesh obj;
+    const auto extent = static_cast<float>(size);
+    for (std::uint32_t y = 0; y <= size; y++) {
+        for (std::uint32_t x = 0; x <= size; x++) {
+            const auto u = static_cast<float>(x);
+            const auto v = static_cast<float>(y);
+            obj.positions.insert(obj.positions.end(), {u, v, static_cast<float>((x * y) % 7)});
+            obj.texcoords.insert(obj.texcoords.end(), {u / extent, v / extent});
+        }
+    }
+    obj.normals = {0, 0, 1};
+
+    std::vector<std::array<std::uint32_t, 3>> triangles;
+    for (std::uint32_t y = 0; y != size; y++) {
+        for (std::uint32_t x = 0; x != size; x++) {
+            const auto a = y * (size + 1) + x;
+            const auto c = a + size + 1;
+            triangles.push_back({a, a + 1, c + 1});
+            triangles.push_back({a, c + 1, c});
+        }
+    }
+    std::ranges::shuffle(triangles, std::mt19937{42});
+    for (const auto &triangle : triangles) {
+        for (const auto v : triangle) { obj.corners.push_back({v, v, 0}); }
+    }
+    return obj;
+}
+
+} // namespace
+
+TEST_CASE("the corners having the same attributes are welded, and only them", "[MeshOptimizer]")
+{
+    // note : a cube, its 8 positions are shared by the faces but not their normals
+    ObjMesh cube;
+    cube.positions = {0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1, 1, 0, 1, 1, 1, 1, 0, 1, 1};
+    cube.normals = {0, 0, -1, 0, 0, 1, 0, -1, 0, 0, 1, 0, -1, 0, 0, 1, 0, 0};
+    cube.texcoords = {0, 0, 1, 0, 1, 1, 0, 1};
+    constexpr std::array<std::array<std::uint32_t, 4>, 6> faces{
+        {{0, 3, 2, 1}, {4, 5, 6, 7}, {0, 1, 5, 4}, {3, 7, 6, 2}, {0, 4, 7, 3}, {1, 2, 6, 5}}};
+    for (std::uint32_t face = 0; face != faces.size(); face++) {
+        for (const std::uint32_t k : {0u, 1u, 2u, 0u, 2u, 3u}) { cube.corners.push_back({faces[face][k], k, face}); }
+    }
+
+    const auto mesh = MeshOptimizer::weld(cube);
+    CHECK(mesh.vertex_count() == 24);
+    CHECK(mesh.normals.size() == 24 * 3);
+    CHECK(mesh.texcoords.size() == 24 * 2);
+    REQUIRE(mesh.indices.size() == 36);
+    CHECK(std::ranges::all_of(mesh.indices, [](auto index) { return index < 24; }));
+
+    // note : the two triangles of a face share their diagonal
+    for (std::size_t face = 0; face != faces.size(); face++) {
+        const auto *indices = &mesh.indices[face * 6];
+        CHECK(indices[0] == indices[3]);
+        CHECK(indices[2] == indices[4]);
+        CHECK(indices[1] != indices[5]);
+    }
+}
+
+TEST_CASE("the positions equal as floats are welded", "[MeshOptimizer]")
+{
+    ObjMesh obj;
+    obj.positions = {0, 0, 0, -0.0f, 0, 0, 1, 0, 0, 0, 1, 0, 0, 1, 0};
+    obj.corners = {
+        {0, NONE, NONE}, {2, NONE, NONE}, {3, NONE, NONE}, {1, NONE, NONE}, {4, NONE, NONE}, {2, NONE, NONE}};
+
+    const auto mesh = MeshOptimizer::weld(obj);
+    CHECK(mesh.vertex_count() == 3);
+    CHECK(mesh.indices == std::vector<std::uint32_t>{0, 1, 2, 0, 2, 1});
+    // note : the missing attributes are zeroed
+    CHECK(mesh.normals == std::vector<float>(3 * 3, 0.0f));
+    CHECK(mesh.texcoords == std::vector<float>(3 * 2, 0.0f));
+}
+
+TEST_CASE("the optimizations reorder the triangles without changing them", "[MeshOptimizer]")
+{
+    constexpr std::uint32_t SIZE = 100;
+    auto mesh = MeshOptimizer::weld(grid(SIZE));
+    REQUIRE(mesh.vertex_count() == (SIZE + 1) * (SIZE + 1));
+    const auto triangles = triangles_of(mesh);
+    const auto shuffled = MeshOptimizer::acmr(mesh.indices, mesh.vertex_count());
+
+    SECTION("the vertex cache")
+    {
+        const auto clusters = MeshOptimizer::optimize_vertex_cache(mesh.indices, mesh.vertex_count());
+        CHECK(triangles_of(mesh) == triangles);
+        REQUIRE_FALSE(clusters.empty());
+        CHECK(clusters.front() == 0);
+        CHECK(std::ranges::is_sorted(clusters));
+        const auto optimized = MeshOptimizer::acmr(mesh.indices, mesh.vertex_count());
+        CHECK(optimized < 1.0f);
+        CHECK(optimized < shuffled / 2.0f);
+
+        MeshOptimizer::optimize_overdraw(mesh.indices, mesh.positions, clusters);
+        CHECK(triangles_of(mesh) == triangles);
+        CHECK(
+            MeshOptimizer::acmr(mesh.indices, mesh.vertex_count())
+            <= optimized * MeshOptimizer::OVERDRAW_THRESHOLD + 0.01f);
+    }
+
+    SECTION("all of them")
+    {
+        MeshOptimizer::optimize(mesh);
+        CHECK(triangles_of(mesh) == triangles);
+        CHECK(MeshOptimizer::acmr(mesh.indices, mesh.vertex_count()) < shuffled / 2.0f);
+
+        // note : the vertices are fetched in the order the triangles first use them
+        std::uint32_t next = 0;
+        const auto in_order = std::ranges::all_of(mesh.indices, [&next](auto index) {
+            if (index == next) { next++; }
+            return index < next;
+        });
+        CHECK(in_order);
+        CHECK(next == mesh.vertex_count());
+    }
+}
+
+TEST_CASE("the miss ratio of a cache of vertices", "[MeshOptimizer]")
+{
+    const std::vector<std::uint32_t> strip{0, 1, 2, 2, 1, 3, 2, 3, 4, 4, 3, 5};
+    CHECK(MeshOptimizer::acmr(strip, 6) == Approx(6.0f / 4.0f));
+    CHECK(MeshOptimizer::acmr(strip, 6, 1) == Approx(10.0f / 4.0f));
+    CHECK(MeshOptimizer::acmr({}, 0) == 0.0f);
+}
+
+TEST_CASE("an empty mesh is left empty", "[MeshOptimizer]")
+{
+    MeshOptimizer::Mesh mesh;
+    MeshOptimizer::optimize(mesh);
+    CHECK(mesh.indices.empty());
+    CHECK(mesh.vertex_count() == 0);
+    CHECK(MeshOptimizer::weld(ObjMesh{}).indices.empty());
+}
@@ -0,0 +1,174 @@
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "resources/ObjMesh.hpp"
+
+namespace {
+
+using kawe::ObjMesh;
+
+struct TemporaryObj {
+    std::filesystem::path path{std::filesystem::temp_directory_path() / "kawe_test.obj"};
+
+    explicit TemporaryObj(std::string_view content)
+    {
+        std::ofstream{path, std::ios::binary}.write(content.data(), static_cast<std::streamsize>(content.size()));
+    }
+
+    ~TemporaryObj()
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+};
+
+auto corner(std::uint32_t position, std::uint32_t texcoord, std::uint32_t normal) -> ObjMesh::Corner
+{
+    return {position, texcoord, normal};
+}
+
+auto equal(const ObjMesh::Corner &lhs, const ObjMesh::Corner &rhs) -> bool
+{
+    return lhs.position == rhs.position && lhs.texcoord == rhs.texcoord && lhs.normal == rhs.normal;
+}
+
+constexpr auto NONE = ObjMesh::NONE;
+
+} // namespace
+
+TEST_CASE("the faces index the attributes they give", "[ObjMesh]")
+{
+    const TemporaryObj obj{
+        "# a quad, then a triangle of each kind of corner\n"
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+        "vt 0 0\nvt 1 0\nvt 1 1\n"
+        "vn 0 0 1\nvn 0 0 -1\n"
+        "f 1/1/1 2/2/1 3/3/1 4/1/1\n"
+        "f 1 2 3\n"
+        "f 1/1 2/2 3/3\n"
+        "f 1//2 2//2 3//2\n"
+        "f 1/3/2 2//1 3/2\n"};
+
+    const auto mesh = ObjMesh::load(obj.path);
+    REQUIRE(mesh.has_value());
+    CHECK(mesh->positions.size() == 4 * 3);
+    CHECK(mesh->texcoords.size() == 3 * 2);
+    CHECK(mesh->normals.size() == 2 * 3);
+
+    // note : the quad is split in a fan around its first corner
+    const auto expected = std::to_array(
+        {corner(0, 0, 0),
+         corner(1, 1, 0),
+         corner(2, 2, 0),
+         corner(0, 0, 0),
+         corner(2, 2, 0),
+         corner(3, 0, 0),
+         corner(0, NONE, NONE),
+         corner(1, NONE, NONE),
+         corner(2, NONE, NONE),
+         corner(0, 0, NONE),
+         corner(1, 1, NONE),
+         corner(2, 2, NONE),
+         corner(0, NONE, 1),
+         corner(1, NONE, 1),
+         corner(2, NONE, 1),
+         corner(0, 2, 1),
+         corner(1, NONE, 0),
+         corner(2, 1, NONE)});
+    REQUIRE(mesh->corners.size() == expected.size());
+    for (std::size_t i = 0; i != expected.size(); i++) {
+        INFO("corner " << i);
+        CHECK(equal(mesh->corners[i], expected[i]));
+    }
+}
+
+TEST_CASE("the negative indices count from the last attribute read", "[ObjMesh]")
+{
+    const TemporaryObj obj{"v 0 0 0\nv 1 0 0\nv 1 1 0\nvn 0 0 1\nf -3//-1 -2//-1 -1//-1\nv 0 1 0\nf -4 -2 -1\n"};
+
+    const auto mesh = ObjMesh::load(obj.path);
+    REQUIRE(mesh.has_value());
+    REQUIRE(mesh->corners.size() == 6);
+    CHECK(equal(mesh->corners[0], corner(0, NONE, 0)));
+    CHECK(equal(mesh->corners[2], corner(2, NONE, 0)));
+    CHECK(equal(mesh->corners[3], corner(0, NONE, NONE)));
+    CHECK(equal(mesh->corners[5], corner(3, NONE, NONE)));
+}
+
+TEST_CASE("the other statements and the malformed lines are skipped", "[ObjMesh]")
+{
+    const TemporaryObj obj{
+        "mtllib a.mtl\r\no thing\r\ng group\r\nusemtl m\r\ns off\r\n"
+        "v 0 0 0\r\nv 1 0 +0\r\nv 1 1 0 1.0\r\nvt 0.5\r\n"
+        "f 1 2\r\nf 1 2 x\r\n  f\t1/1 2/1 3/1"};
+
+    const auto mesh = ObjMesh::load(obj.path);
+    REQUIRE(mesh.has_value());
+    // note : `w` is dropped, a missing `v` of a texcoord is 0
+    CHECK(mesh->positions == std::vector<float>{0, 0, 0, 1, 0, 0, 1, 1, 0});
+    CHECK(mesh->texcoords == std::vector<float>{0.5f, 0.0f});
+    REQUIRE(mesh->corners.size() == 3);
+    CHECK(equal(mesh->corners[2], corner(2, 0, NONE)));
+}
+
+TEST_CASE("a face indexing a missing vertex fails the load", "[ObjMesh]")
+{
+    const auto content = GENERATE(
+        std::string_view{"v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 4\n"},
+        std::string_view{"v 0 0 0\nv 1 0 0\nv 1 1 0\nf -4 -2 -1\n"},
+        std::string_view{"v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1/1 2/1 3/1\n"});
+    const TemporaryObj obj{content};
+
+    CHECK_FALSE(ObjMesh::load(obj.path).has_value());
+}
+
+TEST_CASE("a file split in chunks is parsed as a whole", "[ObjMesh]")
+{
+    // note : a few MiB, so it is split in as many chunks as threads, the relative indices cross their bounds
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> coordinate{-1000, 1000};
+    std::string content;
+    std::vector<float> positions;
+    std::size_t faces = 0;
+    for (std::size_t i = 0; i != 200'000; i++) {
+        const std::array<int, 3> position{coordinate(rng), coordinate(rng), coordinate(rng)};
+        content += "v " + std::to_string(position[0]) + ' ' + std::to_string(position[1]) + ' '
+                   + std::to_string(position[2]) + '\n';
+        positions.insert(positions.end(), position.begin(), position.end());
+        if (i >= 2) {
+            content += i % 2 == 0 ? "f -1 -2 -3\n" : "f 1 " + std::to_string(i + 1) + " -2\n";
+            faces++;
+        }
+    }
+    REQUIRE(content.size() > 4 * ObjMesh::MIN_CHUNK_SIZE);
+    const TemporaryObj obj{content};
+
+    const auto single = ObjMesh::load(obj.path, 1);
+    REQUIRE(single.has_value());
+    CHECK(single->positions == positions);
+    REQUIRE(single->corners.size() == faces * 3);
+
+    for (const std::size_t threads : {std::size_t{2}, std::size_t{3}, std::size_t{8}}) {
+        INFO(threads << " threads");
+        const auto split = ObjMesh::load(obj.path, threads);
+        REQUIRE(split.has_value());
+        CHECK(split->positions == single->positions);
+        REQUIRE(split->corners.size() == single->corners.size());
+        CHECK(std::equal(
+            split->corners.begin(), split->corners.end(), single->corners.begin(), single->corners.end(), equal));
+    }
+
+    // note : the last face mixes an absolute and a relative index
+    const auto last = single->corners.size() - 3;
+    CHECK(equal(single->corners[last], corner(0, NONE, NONE)));
+    CHECK(equal(single->corners[last + 1], corner(199'999, NONE, NONE)));
+    CHECK(equal(single->corners[last + 2], corner(199'998, NONE, NONE)));
+}
@@ -0,0 +1,79 @@
+#include <string>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+#include "helpers/RingBuffer.hpp"
+
+TEST_CASE("the elements are popped in the order they are pushed", "[RingBuffer]")
+{
+    kawe::RingBuffer<int, 4> buffer;
+
+    CHECK(buffer.empty());
+    CHECK(buffer.front() == nullptr);
+    CHECK_FALSE(buffer.try_pop().has_value());
+
+    // note : more elements than the capacity go through it, the indexes wrap around the storage
+    for (int i = 0; i != 10; i++) {
+        REQUIRE(buffer.push(i));
+        REQUIRE(buffer.push(i + 100));
+        CHECK(buffer.size() == 2);
+        CHECK(buffer.try_pop() == i);
+        CHECK(*buffer.front() == i + 100);
+        buffer.pop();
+    }
+    CHECK(buffer.empty());
+}
+
+TEST_CASE("a full buffer refuses the element pushed", "[RingBuffer]")
+{
+    kawe::RingBuffer<std::string, 4> buffer;
+
+    for (int i = 0; i != 4; i++) { REQUIRE(buffer.push(std::to_string(i))); }
+    CHECK(buffer.size() == buffer.capacity());
+    CHECK_FALSE(buffer.push("refused"));
+
+    // note : the refused element did not overwrite the oldest one
+    CHECK(buffer.try_pop() == "0");
+    CHECK(buffer.push("4"));
+    for (const auto *expected : {"1", "2", "3", "4"}) { CHECK(buffer.try_pop() == expected); }
+}
+
+TEST_CASE("clear drops every element", "[RingBuffer]")
+{
+    kawe::RingBuffer<int, 8> buffer;
+
+    for (int i = 0; i != 5; i++) { REQUIRE(buffer.push(i)); }
+    buffer.clear();
+
+    CHECK(buffer.empty());
+    CHECK(buffer.push(42));
+    CHECK(buffer.try_pop() == 42);
+}
+
+TEST_CASE("a producer and a consumer thread share the buffer", "[RingBuffer]")
+{
+    constexpr std::size_t COUNT = 100'000;
+    kawe::RingBuffer<std::size_t, 64> buffer;
+
+    std::thread producer{[&buffer] {
+        for (std::size_t i = 0; i != COUNT; i++) {
+            while (!buffer.push(i)) { std::this_thread::yield(); }
+        }
+    }};
+
+    std::size_t expected = 0;
+    bool ordered = true;
+    while (expected != COUNT) {
+        if (const auto value = buffer.try_pop(); value.has_value()) {
+            ordered = ordered && *value == expected;
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    CHECK(ordered);
+    CHECK(buffer.empty());
+}
@@ -0,0 +1,156 @@
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "TimerWheel.hpp"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("a timer fires on the tick it expires", "[TimerWheel]")
+{
+    kawe::TimerWheel wheel;
+
+    // note : the delays go up to the third level, the timers are cascaded down to the first one
+    std::mt19937 rng{42};
+    std::vector<std::int64_t> expected(500);
+    std::vector<std::int64_t> fired(expected.size(), -1);
+    for (std::size_t i = 0; i != expected.size(); i++) {
+        expected[i] = std::uniform_int_distribution<std::int64_t>{1, 300'000}(rng);
+        wheel.schedule(kawe::TimerWheel::duration{expected[i]}, [&, i] { fired[i] = wheel.now().count(); });
+    }
+
+    // note : an uneven frame time, the fraction of a tick left is carried to the next frame
+    for (auto frame = 0; frame != 40'000; frame++) { wheel.advance(7777us); }
+
+    CHECK(fired == expected);
+    CHECK(wheel.size() == 0);
+}
+
+TEST_CASE("a timer crossing a slot boundary fires on time", "[TimerWheel]")
+{
+    kawe::TimerWheel wheel;
+
+    // note : 64 slots per level, the timers are scheduled right before the first and the second level wrap around
+    for (const auto start : {62ms, 4094ms, 262'142ms}) {
+        wheel.advance(start - wheel.now());
+
+        std::int64_t fired = -1;
+        wheel.schedule(3ms, [&] { fired = wheel.now().count(); });
+        wheel.advance(2ms);
+        CHECK(fired == -1);
+        wheel.advance(1ms);
+        CHECK(fired == (start + 3ms).count());
+    }
+}
+
+TEST_CASE("a timer past the range of the wheel waits in the last level", "[TimerWheel]")
+{
+    kawe::TimerWheel wheel;
+
+    bool fired = false;
+    const auto far = wheel.schedule(kawe::TimerWheel::duration{std::int64_t{1} << 31}, [&] { fired = true; });
+    wheel.advance(10s);
+
+    CHECK(wheel.is_pending(far));
+    CHECK_FALSE(fired);
+    CHECK(wheel.cancel(far));
+    CHECK(wheel.size() == 0);
+}
+
+TEST_CASE("a periodic timer fires until it is cancelled", "[TimerWheel]")
+{
+    kawe::TimerWheel wheel;
+
+    int count = 0;
+    const auto handle = wheel.schedule(10ms, [&] { count++; }, 10ms);
+    wheel.advance(100ms);
+    CHECK(count == 10);
+
+    CHECK(wheel.cancel(handle));
+    wheel.advance(100ms);
+    CHECK(count == 10);
+    CHECK_FALSE(wheel.cancel(handle));
+    CHECK_FALSE(wheel.is_pending(handle));
+}
+
+TEST_CASE("a callback can cancel its own timer and schedule an other one", "[TimerWheel]")
+{
+    kawe::TimerWheel wheel;
+
+    int count = 0;
+    int scheduled = 0;
+    kawe::TimerWheel::Handle self;
+    self = wheel.schedule(
+        5ms,
+        [&] {
+            count++;
+            wheel.cancel(self);
+            wheel.schedule(1ms, [&] { scheduled++; });
+        },
+        5ms);
+    wheel.advance(50ms);
+
+    CHECK(count == 1);
+    CHECK(scheduled == 1);
+    CHECK(wheel.size() == 0);
+}
+
+TEST_CASE("a released handle does not match the timer reusing its node", "[TimerWheel]")
+{
+    kawe::TimerWheel wheel;
+
+    const auto first = wheel.schedule(1ms, [] {});
+    wheel.advance(1ms);
+    const auto second = wheel.schedule(1ms, [] {});
+
+    CHECK(first.index == second.index);
+    CHECK_FALSE(wheel.is_pending(first));
+    CHECK_FALSE(wheel.cancel(first));
+    CHECK(wheel.is_pending(second));
+}
+
+TEST_CASE("a handle from before a clear does not match the timers scheduled after", "[TimerWheel]")
+{
+    kawe::TimerWheel wheel;
+
+    int fired = 0;
+    const auto before = wheel.schedule(10ms, [&] { fired++; });
+    wheel.schedule(5000ms, [&] { fired++; });
+    wheel.advance(3ms);
+    wheel.clear();
+    CHECK(wheel.size() == 0);
+    CHECK(wheel.now() == 3ms);
+
+    // note : the two nodes are reused, one of them by a timer having the index of `before`
+    const auto after = wheel.schedule(10ms, [&] { fired++; });
+    const auto other = wheel.schedule(20ms, [] {});
+    CHECK((after.index == before.index || other.index == before.index));
+    CHECK_FALSE(wheel.is_pending(before));
+    CHECK_FALSE(wheel.cancel(before));
+    CHECK(wheel.is_pending(after));
+    CHECK(wheel.is_pending(other));
+
+    wheel.advance(6000ms);
+    CHECK(fired == 1);
+}
+
+TEST_CASE("a callback can clear the wheel", "[TimerWheel]")
+{
+    kawe::TimerWheel wheel;
+
+    int fired = 0;
+    wheel.schedule(
+        5ms,
+        [&] {
+            fired++;
+            wheel.clear();
+        },
+        5ms);
+    wheel.schedule(6ms, [&] { fired++; });
+    wheel.schedule(3000ms, [&] { fired++; });
+    wheel.advance(5000ms);
+
+    CHECK(fired == 1);
+    CHECK(wheel.size() == 0);
+}